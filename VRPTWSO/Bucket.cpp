@@ -1,223 +1,375 @@
-#include "Bucket.h"
-
-//Vertex
-Vertex::Vertex(int numEq) : job(-1), time(-1)
-{
-	adjacenceList = vector<vector<Vertex*>>(numEq, vector<Vertex*>());
-	incidenceList = vector<vector<Vertex*>>(numEq, vector<Vertex*>());
-}
-
-Vertex::~Vertex()
-{
-	adjacenceList.clear();
-	incidenceList.clear();
-}
-
-void Vertex::addInicidentVertex(int eqType, Vertex *v)
-{
-	incidenceList[eqType].push_back(v);
-}
-
-void Vertex::addAdjacentVertex(int eqType, Vertex *v)
-{
-	adjacenceList[eqType].push_back(v);
-}
-
-//Label
-bool Label::operator<(const Label& other) const{
-	//By cost
-	if(this->getCost() < other.getCost())
-		return true;
-	else if(this->getCost() > other.getCost())
-		return false;
-
-	//By job
-	if(this->getJob() < other.getJob())
-		return true;
-	else if(this->getJob() > other.getJob())
-		return false;
-
-	//By time
-	if(this->getTime() < other.getTime())
-		return true;
-	else if(this->getTime() > other.getTime())
-		return false;
-
-	return false;
-}
-
-//BUCKET
-void Bucket::reset()
-{
-	//Free memory
-	set<Label*,LabelComparator>::iterator it = labels.begin();
-	for(; it != labels.end(); it++){
-		delete (*it);
-	}
-	labels.clear();
-
-	successor = nullptr; 
-}
-
-//QROUTE BUCKET
-void QRouteBucket::evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix)
-{
-	//Create label
-	Label *myLabel = new Label(job,time);
-
-	//Evaluate best label of oLabels (if such exist)
-	if(oLabels.size() > 0){
-		Label *pLabel = (*oLabels.begin());
-
-		//set label cost
-		myLabel->setCost(pLabel->getCost() + rCost);
-		myLabel->setPredecessor(pLabel);
-		myLabel->setFixed(fix);
-	}
-
-	//Add the route
-	pair<set<Label*,LabelComparator>::iterator,bool> success;
-	success = labels.insert(myLabel);
-	if(success.second == false){
-		delete myLabel;
-	}
-
-	//Mantain the label structure of propper size
-	if(labels.size() > parameters->getMaxRoutes()){
-		set<Label*,LabelComparator>::iterator it = labels.end();
-		--it;
-		Label *tempLabel = (*it);
-		labels.erase(it);
-		delete tempLabel;
-	}
-
-	//Evaluate best label of oLabels (if such exist)
-	//if(oLabels.size() > 0){
-	//	Label *pLabel = oLabels[0];
-
-	//	//set label cost
-	//	myLabel->setCost(pLabel->getCost() + rCost);
-	//	myLabel->setPredecessor(pLabel);
-	//	myLabel->setFixed(fix);
-	//}
-
-	////Dominance Check (same bucket)
-	//if(labels.size() == 0)
-	//	labels.push_back(myLabel);
-	//else
-	//{
-	//	Label *bestLabel = labels[0];
-	//	if(*myLabel < *bestLabel)
-	//	{
-	//		labels[0] = myLabel;
-	//		delete bestLabel;
-	//	}			
-	//}
-}
-
-Label* QRouteBucket::getBestLabel()
-{
-	if(labels.size() > 0)
-		return *labels.begin();
-	return nullptr;
-}
-
-//QROUTENOLOOP BUCKET
-void QRouteNoLoopBucket::evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix)
-{
-	//Create Label
-	Label *myLabel = new Label(job,time);
-
-	//Get best label of predecessor
-	set<Label*,LabelComparator>::iterator it = oLabels.begin();
-	for(; it != oLabels.end(); it++){
-		Label *pLabel = (*it);
-		Label *predecessor = pLabel->getPredecessor();
-		//Avoid Loop
-		if(job != 0){
-			if(predecessor != nullptr && predecessor->getJob() == job) continue;
-		}
-		//No Loop at this point 		
-		myLabel->setCost(pLabel->getCost() + rCost);
-		if(pLabel->getJob() != job)
-			myLabel->setPredecessor(pLabel);
-		else
-			myLabel->setPredecessor(predecessor);
-		myLabel->setFixed(fix);
-
-		break;
-	}
-
-	//Add the route
-	pair<set<Label*,LabelComparator>::iterator,bool> success;
-	success = labels.insert(myLabel);
-	if(success.second == false){
-		delete myLabel;
-	}
-
-	//Mantain the label structure of propper size
-	if(labels.size() > parameters->getMaxRoutes()){
-		set<Label*,LabelComparator>::iterator it = labels.end();
-		--it;
-		Label *tempLabel = (*it);
-		labels.erase(it);
-		delete tempLabel;
-	}
-
-	////Get best label of predecessor
-	//int pSize = oLabels.size() -1;
-	//for(int i=0; i < 2; i++){
-	//	if(i > pSize) break;
-
-	//	Label *pLabel = oLabels[i];
-	//	Label *predecessor = pLabel->getPredecessor();
-	//	//Avoid Loop
-	//	if(job != 0){
-	//		if(predecessor != nullptr && predecessor->getJob() == job) continue;
-	//	}
-	//	//No Loop at this point 		
-	//	myLabel->setCost(pLabel->getCost() + rCost);
-	//	if(pLabel->getJob() != job)
-	//		myLabel->setPredecessor(pLabel);
-	//	else
-	//		myLabel->setPredecessor(predecessor);
-	//	myLabel->setFixed(fix);
-
-	//	break;
-	//}
-
-	//Dominance Check (same bucket)
-	/*int numLabels = labels.size();
-	if(numLabels == 0){
-		labels.push_back(myLabel);
-	}else if(numLabels == 1){
-		labels.resize(2);
-		if(myLabel->getCost() < labels[0]->getCost()){
-			labels[1] = labels[0];
-			labels[0] = myLabel;
-		}else{
-			labels[1] = myLabel;
-		}
-	}else if(numLabels == 2){
-		if(myLabel->getCost() < labels[0]->getCost()){
-			delete labels[1];
-			labels[1] = labels[0];
-			labels[0] = myLabel;
-		}else if(myLabel->getCost() < labels[1]->getCost()){
-			delete labels[1];
-			labels[1] = myLabel;
-		}else{
-			delete myLabel;
-		}
-	}else{
-		delete myLabel;
-		labels.resize(2);
-	}*/
-}
-
-Label* QRouteNoLoopBucket::getBestLabel()
-{
-	if(labels.size() > 0)
-		return *labels.begin();
-	return nullptr;
-}
+#include "Bucket.h"
+
+#include <algorithm>
+
+//Vertex
+Vertex::Vertex(int numEq) : job(-1), time(-1), id(-1)
+{
+	adjacenceList = vector<vector<Vertex*>>(numEq, vector<Vertex*>());
+	incidenceList = vector<vector<Vertex*>>(numEq, vector<Vertex*>());
+	firstArc = vector<int>(numEq, -1);
+}
+
+Vertex::~Vertex()
+{
+	adjacenceList.clear();
+	incidenceList.clear();
+}
+
+void Vertex::addInicidentVertex(int eqType, Vertex *v)
+{
+	incidenceList[eqType].push_back(v);
+}
+
+void Vertex::addAdjacentVertex(int eqType, Vertex *v)
+{
+	adjacenceList[eqType].push_back(v);
+}
+
+//VertexIndex
+void VertexIndex::reserve(int job, int first, int last)
+{
+	//Range of a job known in advance (the network builder), so no vertex moves later
+	firstTime[job] = first;
+	vertices[job] = vector<Vertex*>((last >= first)? last - first + 1 : 0, nullptr);
+}
+
+void VertexIndex::add(Vertex *v)
+{
+	int job = v->getJob();
+	int t = v->getTime();
+	vector<Vertex*> &range = vertices[job];
+
+	if(range.size() == 0){
+		firstTime[job] = t;
+		range.push_back(v);
+		return;
+	}
+
+	//Grow the range of the job to include t
+	if(t < firstTime[job]){
+		range.insert(range.begin(), firstTime[job] - t, nullptr);
+		firstTime[job] = t;
+	}else if(t - firstTime[job] >= (int)range.size()){
+		range.resize(t - firstTime[job] + 1, nullptr);
+	}
+	range[t - firstTime[job]] = v;
+}
+
+void VertexIndex::clear()
+{
+	for(unsigned int j=0; j < vertices.size(); j++){
+		vector<Vertex*>().swap(vertices[j]);
+		firstTime[j] = 0;
+	}
+}
+
+//Label
+bool Label::operator<(const Label& other) const{
+	//By cost
+	if(this->getCost() < other.getCost())
+		return true;
+	else if(this->getCost() > other.getCost())
+		return false;
+
+	//By job
+	if(this->getJob() < other.getJob())
+		return true;
+	else if(this->getJob() > other.getJob())
+		return false;
+
+	//By time
+	if(this->getTime() < other.getTime())
+		return true;
+	else if(this->getTime() > other.getTime())
+		return false;
+
+	return false;
+}
+
+//BUCKET
+void Bucket::reset()
+{
+	//Free memory
+	set<Label*,LabelComparator>::iterator it = labels.begin();
+	for(; it != labels.end(); it++){
+		delete (*it);
+	}
+	labels.clear();
+
+	successor = nullptr; 
+}
+
+bool Bucket::addNonDominated(Label *l, const vector<double> &penalties)
+{
+	//Label l1 dominates l2 if it is cheaper even after paying the subset row cuts that l1 may still pay and l2 not
+	//(and it is not more loaded)
+	set<Label*,LabelComparator>::iterator it = labels.begin();
+	while(it != labels.end()){
+		Label *other = (*it);
+		if(other->getCost() <= l->getCost()){
+			if(other->getLoad() > l->getLoad()){
+				it++;
+				continue;
+			}
+			double cost = other->getCost();
+			unsigned long long extra = other->getSubsetRowState() & ~l->getSubsetRowState();
+			for(unsigned int c=0; c < penalties.size() && extra != 0 && cost <= l->getCost(); c++, extra >>= 1){
+				if(extra & 1ULL) cost += penalties[c];
+			}
+			if(cost <= l->getCost()){
+				delete l;
+				return false;
+			}
+			it++;
+		}else{
+			if(l->getLoad() > other->getLoad()){
+				it++;
+				continue;
+			}
+			double cost = l->getCost();
+			unsigned long long extra = l->getSubsetRowState() & ~other->getSubsetRowState();
+			for(unsigned int c=0; c < penalties.size() && extra != 0 && cost <= other->getCost(); c++, extra >>= 1){
+				if(extra & 1ULL) cost += penalties[c];
+			}
+			if(cost <= other->getCost()){
+				labels.erase(it++);
+				delete other;
+			}else{
+				it++;
+			}
+		}
+	}
+
+	pair<set<Label*,LabelComparator>::iterator,bool> success = labels.insert(l);
+	if(success.second == false){
+		delete l;
+		return false;
+	}
+
+	//Mantain the label structure of propper size
+	if((int)labels.size() > parameters->getMaxRoutes()){
+		it = labels.end();
+		--it;
+		Label *tempLabel = (*it);
+		bool kept = (tempLabel != l);
+		labels.erase(it);
+		delete tempLabel;
+		return kept;
+	}
+	return true;
+}
+
+//QROUTE BUCKET
+void QRouteBucket::evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix, int departure)
+{
+	//Create label
+	Label *myLabel = new Label(job,time);
+
+	//Evaluate best label of oLabels (if such exist)
+	if(oLabels.size() > 0){
+		Label *pLabel = (*oLabels.begin());
+
+		//set label cost
+		myLabel->setCost(pLabel->getCost() + rCost);
+		myLabel->setPredecessor(pLabel);
+		myLabel->setFixed(fix);
+		if(pLabel->getJob() != job) myLabel->setDepartureTime(departure);
+	}
+
+	//Add the route
+	pair<set<Label*,LabelComparator>::iterator,bool> success;
+	success = labels.insert(myLabel);
+	if(success.second == false){
+		delete myLabel;
+	}
+
+	//Mantain the label structure of propper size
+	if((int)labels.size() > parameters->getMaxRoutes()){
+		set<Label*,LabelComparator>::iterator it = labels.end();
+		--it;
+		Label *tempLabel = (*it);
+		labels.erase(it);
+		delete tempLabel;
+	}
+
+	//Evaluate best label of oLabels (if such exist)
+	//if(oLabels.size() > 0){
+	//	Label *pLabel = oLabels[0];
+
+	//	//set label cost
+	//	myLabel->setCost(pLabel->getCost() + rCost);
+	//	myLabel->setPredecessor(pLabel);
+	//	myLabel->setFixed(fix);
+	//}
+
+	////Dominance Check (same bucket)
+	//if(labels.size() == 0)
+	//	labels.push_back(myLabel);
+	//else
+	//{
+	//	Label *bestLabel = labels[0];
+	//	if(*myLabel < *bestLabel)
+	//	{
+	//		labels[0] = myLabel;
+	//		delete bestLabel;
+	//	}			
+	//}
+}
+
+Label* QRouteBucket::getBestLabel()
+{
+	if(labels.size() > 0)
+		return *labels.begin();
+	return nullptr;
+}
+
+//QROUTENOLOOP BUCKET
+void QRouteNoLoopBucket::evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix, int departure)
+{
+	//Create Label
+	Label *myLabel = new Label(job,time);
+
+	//Get best label of predecessor
+	set<Label*,LabelComparator>::iterator it = oLabels.begin();
+	for(; it != oLabels.end(); it++){
+		Label *pLabel = (*it);
+		Label *predecessor = pLabel->getPredecessor();
+		//Avoid Loop
+		if(job != 0){
+			if(predecessor != nullptr && predecessor->getJob() == job) continue;
+		}
+		//No Loop at this point 		
+		myLabel->setCost(pLabel->getCost() + rCost);
+		if(pLabel->getJob() != job){
+			myLabel->setPredecessor(pLabel);
+			myLabel->setDepartureTime(departure);
+		}else{
+			//Waiting: the label keeps the departure from its predecessor
+			myLabel->setPredecessor(predecessor);
+			myLabel->setDepartureTime(pLabel->getDepartureTime());
+		}
+		myLabel->setFixed(fix);
+
+		break;
+	}
+
+	//Add the route
+	pair<set<Label*,LabelComparator>::iterator,bool> success;
+	success = labels.insert(myLabel);
+	if(success.second == false){
+		delete myLabel;
+	}
+
+	//Mantain the label structure of propper size
+	if((int)labels.size() > parameters->getMaxRoutes()){
+		set<Label*,LabelComparator>::iterator it = labels.end();
+		--it;
+		Label *tempLabel = (*it);
+		labels.erase(it);
+		delete tempLabel;
+	}
+
+	////Get best label of predecessor
+	//int pSize = oLabels.size() -1;
+	//for(int i=0; i < 2; i++){
+	//	if(i > pSize) break;
+
+	//	Label *pLabel = oLabels[i];
+	//	Label *predecessor = pLabel->getPredecessor();
+	//	//Avoid Loop
+	//	if(job != 0){
+	//		if(predecessor != nullptr && predecessor->getJob() == job) continue;
+	//	}
+	//	//No Loop at this point 		
+	//	myLabel->setCost(pLabel->getCost() + rCost);
+	//	if(pLabel->getJob() != job)
+	//		myLabel->setPredecessor(pLabel);
+	//	else
+	//		myLabel->setPredecessor(predecessor);
+	//	myLabel->setFixed(fix);
+
+	//	break;
+	//}
+
+	//Dominance Check (same bucket)
+	/*int numLabels = labels.size();
+	if(numLabels == 0){
+		labels.push_back(myLabel);
+	}else if(numLabels == 1){
+		labels.resize(2);
+		if(myLabel->getCost() < labels[0]->getCost()){
+			labels[1] = labels[0];
+			labels[0] = myLabel;
+		}else{
+			labels[1] = myLabel;
+		}
+	}else if(numLabels == 2){
+		if(myLabel->getCost() < labels[0]->getCost()){
+			delete labels[1];
+			labels[1] = labels[0];
+			labels[0] = myLabel;
+		}else if(myLabel->getCost() < labels[1]->getCost()){
+			delete labels[1];
+			labels[1] = myLabel;
+		}else{
+			delete myLabel;
+		}
+	}else{
+		delete myLabel;
+		labels.resize(2);
+	}*/
+}
+
+Label* QRouteNoLoopBucket::getBestLabel()
+{
+	if(labels.size() > 0)
+		return *labels.begin();
+	return nullptr;
+}
+
+//PARETO BUCKET
+void ParetoBucket::reset()
+{
+	Bucket::reset();
+	frontLoads.clear();
+	frontCosts.clear();
+	frontLabels.clear();
+}
+
+bool ParetoBucket::addParetoLabel(Label *l)
+{
+	//Labels before position p are less loaded, the first of them that is not cheaper dominates l.
+	//From p on, l dominates the labels while they are not cheaper (the costs decrease along the front)
+	int load = l->getLoad();
+	double cost = l->getCost();
+	int p = lower_bound(frontLoads.begin(), frontLoads.end(), load) - frontLoads.begin();
+	if((p > 0 && frontCosts[p-1] <= cost) || (p < (int)frontLoads.size() && frontLoads[p] == load && frontCosts[p] <= cost)){
+		delete l;
+		return false;
+	}
+
+	int q = p;
+	while(q < (int)frontLoads.size() && frontCosts[q] >= cost){
+		labels.erase(frontLabels[q]);
+		delete frontLabels[q];
+		q++;
+	}
+
+	if(q > p){
+		frontLoads[p] = load;
+		frontCosts[p] = cost;
+		frontLabels[p] = l;
+		frontLoads.erase(frontLoads.begin() + p + 1, frontLoads.begin() + q);
+		frontCosts.erase(frontCosts.begin() + p + 1, frontCosts.begin() + q);
+		frontLabels.erase(frontLabels.begin() + p + 1, frontLabels.begin() + q);
+	}else{
+		frontLoads.insert(frontLoads.begin() + p, load);
+		frontCosts.insert(frontCosts.begin() + p, cost);
+		frontLabels.insert(frontLabels.begin() + p, l);
+	}
+
+	//No label of the front has the cost of l any more
+	labels.insert(l);
+	return true;
+}
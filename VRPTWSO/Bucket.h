@@ -1,197 +1,258 @@
-#pragma once
-
-#include "GlobalParameters.h"
-#include <vector>
-#include <set>
-
-#ifdef DEBUG
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
-#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
-#define new DEBUG_NEW
-#endif
-
-using namespace std;
-
-class Label;
-class Bucket;
-class qRouteBucket;
-class qRouteNoLoopBucket;
-class Vertex;
-
-class Edge
-{
-public:
-	Edge(int i, int j, int t) : sJob(i), eJob(j), time(t){ }
-
-	int getStartJob(){ return sJob; }
-	int getEndJob(){ return eJob; }
-	int getTime(){ return time; }
-
-private:
-	int sJob;
-	int eJob;
-	int time;
-};
-
-class Vertex
-{
-public:
-	Vertex(int numEq);
-	~Vertex();
-
-	//GET METHODS
-	int getJob() const{ return job; }
-	int getTime() const{ return time; }
-	vector<Vertex*> &getAdjacenceList(int eq){ return adjacenceList[eq]; }
-	vector<Vertex*> &getIncidenceList(int eq){ return incidenceList[eq]; }
-
-	//SET METHODS
-	void setJob(int j){ job = j; }
-	void setTime(int t){ time = t; }
-	void addInicidentVertex(int eqType, Vertex *v);
-	void addAdjacentVertex(int eqType, Vertex *v);
-
-
-private:
-	int job, time;
-	vector<vector<Vertex*>> adjacenceList;
-	vector<vector<Vertex*>> incidenceList; //one incidence list per equipment type
-};
-
-class VertexComparator
-{
-public:
-	bool operator()(const Vertex *v1, const Vertex *v2){
-		//Compare by time
-		if(v1->getTime() < v2->getTime())
-			return true;
-		else if(v2->getTime() < v1->getTime())
-			return false;
-
-		//Compare by job
-		if(v1->getJob() < v2->getJob())
-			return true;
-		else if(v2->getTime() < v1->getTime())
-			return false;
-
-		return false;
-	}
-};
-
-class Label
-{
-public:
-	Label() : job(0), time(0), cost(0.0), predecessor(nullptr), fixed(false) {}
-	Label(int j, int t) : job(j), time(t), cost(1e13), predecessor(nullptr), fixed(false) {}
-	Label(int j, int t, double c) : job(j), time(t), cost(c), predecessor(nullptr), fixed(false) {}
-	Label(int j, int t, double c, Label *p) : job(j), time(t), cost(c), predecessor(p), fixed(false) {}
-	~Label(){ predecessor = nullptr; }
-
-	//GET METHODS
-	int getJob() const { return job; }
-	int getTime() const { return time; }
-	double getCost() const { return cost; }
-	Label *getPredecessor(){ return predecessor; }
-	bool isFixed() const{ return fixed; }
-
-	//SET METHODS
-	void setJob(int j){ job = j; }
-	void setTime(int t){ time = t; }
-	void setCost(double c){ cost = c; }
-	void setPredecessor(Label * p){ predecessor = p; }
-	void setFixed(bool f){ fixed = f; }
-
-	bool operator<(const Label& other) const;
-
-private:
-	int job;
-	int time;
-	double cost;
-	bool fixed;
-	Label *predecessor;
-};
-
-class LabelComparator
-{
-public:
-    bool operator()(const Label *l1, const Label *l2){
-        if(l1->getCost() < l2->getCost())
-			return true;
-		else if(l2->getCost() < l1->getCost())
-			return false;
-
-		if(l1->getJob() < l2->getJob())
-			return true;
-		else if(l2->getJob() < l1->getJob())
-			return false;
-
-		if(l1->getTime() < l2->getTime())
-			return true;
-		else if(l2->getTime() < l1->getTime())
-			return false;
-
-		return false;
-    }
-};
-
-class Bucket
-{
-public:
-	Bucket(){};
-	~Bucket(){ reset(); }
-
-	void addLabel(Label *l){ labels.insert(l); }
-	virtual void evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix) = 0;
-	virtual Label *getBestLabel() = 0;
-
-	//GET METHODS
-	Bucket *getSuccessor(){ return successor; }
-	int getJob(){ return job; }
-	int getTime(){ return time; }
-	set<Label *,LabelComparator> &getLabels(){ return labels; }
-
-	//SET METHODS
-	void setJob(int j){ job = j; }
-	void setTime(int t){ time = t; }
-	void setSuccessor(Bucket *b){ successor = b; }
-
-	void reset();
-	bool isEmpty(){ return (labels.size() == 0)? true : false; }
-
-protected:
-	int job;
-	int time;
-	set<Label*,LabelComparator> labels;
-	Bucket *successor;
-	GlobalParameters *parameters;
-};
-
-class QRouteBucket : public Bucket
-{
-public:
-	QRouteBucket() { 
-		successor = nullptr;
-		parameters = GlobalParameters::getInstance(); 
-		labels = set<Label*,LabelComparator>();
-	}
-
-	//Interface methods
-	void evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix);
-	Label *getBestLabel();
-};
-
-class QRouteNoLoopBucket : public Bucket
-{
-public:
-	QRouteNoLoopBucket() { 
-		successor = nullptr;
-		parameters = GlobalParameters::getInstance(); 
-		labels = set<Label*,LabelComparator>();
-	}
-
-	//Interface methods
-	void evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix);
-	Label *getBestLabel();
-};
+#pragma once
+
+#include "GlobalParameters.h"
+#include <vector>
+#include <set>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+class Label;
+class Bucket;
+class qRouteBucket;
+class qRouteNoLoopBucket;
+class Vertex;
+
+class Edge
+{
+public:
+	Edge(int i, int j, int t) : sJob(i), eJob(j), time(t){ }
+
+	int getStartJob(){ return sJob; }
+	int getEndJob(){ return eJob; }
+	int getTime(){ return time; }
+
+private:
+	int sJob;
+	int eJob;
+	int time;
+};
+
+class Vertex
+{
+public:
+	Vertex(int numEq);
+	~Vertex();
+
+	//GET METHODS
+	int getJob() const{ return job; }
+	int getTime() const{ return time; }
+	int getId() const{ return id; }
+	vector<Vertex*> &getAdjacenceList(int eq){ return adjacenceList[eq]; }
+	vector<Vertex*> &getIncidenceList(int eq){ return incidenceList[eq]; }
+	int getArcId(int eq, int k) const{ return firstArc[eq] + k; }
+
+	//SET METHODS
+	void setJob(int j){ job = j; }
+	void setTime(int t){ time = t; }
+	void setId(int i){ id = i; }
+	void addInicidentVertex(int eqType, Vertex *v);
+	void addAdjacentVertex(int eqType, Vertex *v);
+	void setFirstArc(int eqType, int id){ firstArc[eqType] = id; }
+
+private:
+	int job, time;
+	int id; //position in the vertex pool of the problem network (per vertex data of the pricing)
+	vector<vector<Vertex*>> adjacenceList;
+	vector<vector<Vertex*>> incidenceList; //one incidence list per equipment type
+	vector<int> firstArc; //id of the first arc of each adjacence list (arc ids are consecutive)
+};
+
+/**
+* Vertices of a time-expanded network by (job, time). Each job keeps the time range between its first and
+* its last vertex, so lookups are O(1) and memory follows the vertices instead of numJobs x horizon.
+*/
+class VertexIndex
+{
+public:
+	VertexIndex(){}
+	VertexIndex(int numJobs) : firstTime(numJobs, 0), vertices(numJobs) {}
+
+	//GET METHODS
+	Vertex *get(int job, int t) const{
+		int k = t - firstTime[job];
+		return (k >= 0 && k < (int)vertices[job].size())? vertices[job][k] : nullptr;
+	}
+	int getFirstTime(int job) const{ return firstTime[job]; }
+	int getLastTime(int job) const{ return firstTime[job] + (int)vertices[job].size() - 1; }
+
+	void add(Vertex *v);
+	void reserve(int job, int first, int last);
+	void clear();
+
+private:
+	vector<int> firstTime;
+	vector<vector<Vertex*>> vertices;
+};
+
+class VertexComparator
+{
+public:
+	bool operator()(const Vertex *v1, const Vertex *v2){
+		//Compare by time
+		if(v1->getTime() < v2->getTime())
+			return true;
+		else if(v2->getTime() < v1->getTime())
+			return false;
+
+		//Compare by job
+		if(v1->getJob() < v2->getJob())
+			return true;
+		else if(v2->getTime() < v1->getTime())
+			return false;
+
+		return false;
+	}
+};
+
+class Label
+{
+public:
+	Label() : job(0), time(0), cost(0.0), predecessor(nullptr), fixed(false), srcState(0), departure(-1), load(0) {}
+	Label(int j, int t) : job(j), time(t), cost(1e13), predecessor(nullptr), fixed(false), srcState(0), departure(-1), load(0) {}
+	Label(int j, int t, double c) : job(j), time(t), cost(c), predecessor(nullptr), fixed(false), srcState(0), departure(-1), load(0) {}
+	Label(int j, int t, double c, Label *p) : job(j), time(t), cost(c), predecessor(p), fixed(false), srcState(0), departure(-1), load(0) {}
+	~Label(){ predecessor = nullptr; }
+
+	//GET METHODS
+	int getJob() const { return job; }
+	int getTime() const { return time; }
+	double getCost() const { return cost; }
+	Label *getPredecessor(){ return predecessor; }
+	bool isFixed() const{ return fixed; }
+	unsigned long long getSubsetRowState() const{ return srcState; }
+	int getDepartureTime() const{ return departure; }
+	int getLoad() const{ return load; }
+
+	//SET METHODS
+	void setJob(int j){ job = j; }
+	void setTime(int t){ time = t; }
+	void setCost(double c){ cost = c; }
+	void setPredecessor(Label * p){ predecessor = p; }
+	void setFixed(bool f){ fixed = f; }
+	void setSubsetRowState(unsigned long long s){ srcState = s; }
+	void setDepartureTime(int t){ departure = t; }
+	void setLoad(int l){ load = l; }
+
+	bool operator<(const Label& other) const;
+
+private:
+	int job;
+	int time;
+	double cost;
+	bool fixed;
+	Label *predecessor;
+	unsigned long long srcState; //bit c: odd number of visits to the jobs of subset row cut c since entering its memory
+	int departure; //time the route left the job of the predecessor (-1: the time of the predecessor label)
+	int load; //demand of the jobs visited since the route left the depot
+};
+
+class LabelComparator
+{
+public:
+    bool operator()(const Label *l1, const Label *l2){
+        if(l1->getCost() < l2->getCost())
+			return true;
+		else if(l2->getCost() < l1->getCost())
+			return false;
+
+		if(l1->getJob() < l2->getJob())
+			return true;
+		else if(l2->getJob() < l1->getJob())
+			return false;
+
+		if(l1->getTime() < l2->getTime())
+			return true;
+		else if(l2->getTime() < l1->getTime())
+			return false;
+
+		return false;
+    }
+};
+
+class Bucket
+{
+public:
+	Bucket(){};
+	virtual ~Bucket(){ reset(); }
+
+	void addLabel(Label *l){ labels.insert(l); }
+	bool addNonDominated(Label *l, const vector<double> &penalties);
+	virtual void evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix, int departure) = 0;
+	virtual Label *getBestLabel() = 0;
+
+	//GET METHODS
+	Bucket *getSuccessor(){ return successor; }
+	int getJob(){ return job; }
+	int getTime(){ return time; }
+	set<Label *,LabelComparator> &getLabels(){ return labels; }
+
+	//SET METHODS
+	void setJob(int j){ job = j; }
+	void setTime(int t){ time = t; }
+	void setSuccessor(Bucket *b){ successor = b; }
+
+	virtual void reset();
+	bool isEmpty(){ return (labels.size() == 0)? true : false; }
+
+protected:
+	int job;
+	int time;
+	set<Label*,LabelComparator> labels;
+	Bucket *successor;
+	GlobalParameters *parameters;
+};
+
+class QRouteBucket : public Bucket
+{
+public:
+	QRouteBucket() { 
+		successor = nullptr;
+		parameters = GlobalParameters::getInstance(); 
+		labels = set<Label*,LabelComparator>();
+	}
+
+	//Interface methods
+	void evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix, int departure);
+	Label *getBestLabel();
+};
+
+class QRouteNoLoopBucket : public Bucket
+{
+public:
+	QRouteNoLoopBucket() { 
+		successor = nullptr;
+		parameters = GlobalParameters::getInstance(); 
+		labels = set<Label*,LabelComparator>();
+	}
+
+	//Interface methods
+	void evaluate(set<Label*,LabelComparator> oLabels, double rCost, bool fix, int departure);
+	Label *getBestLabel();
+};
+
+/**
+* Bucket of the pricing with a load resource (equipment capacities). A label is kept while no other label of
+* the bucket is both cheaper and less loaded. The Pareto front is kept in flat arrays sorted by load (so its
+* costs decrease), where a dominance check is a binary search; the labels are in the label set as well.
+*/
+class ParetoBucket : public QRouteNoLoopBucket
+{
+public:
+	ParetoBucket() : QRouteNoLoopBucket() {}
+
+	bool addParetoLabel(Label *l);
+	void reset();
+
+private:
+	vector<int> frontLoads;
+	vector<double> frontCosts;
+	vector<Label*> frontLabels;
+};
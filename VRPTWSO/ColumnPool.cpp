@@ -0,0 +1,54 @@
+#include "ColumnPool.h"
+#include "SubproblemSolver.h"
+
+ColumnPool::ColumnPool(int size) : maxSize(size)
+{
+	parameters = GlobalParameters::getInstance();
+	routes = deque<Route*>();
+	omp_init_lock(&lock);
+}
+
+ColumnPool::~ColumnPool()
+{
+	for(unsigned int i=0; i < routes.size(); i++){
+		delete routes[i];
+	}
+	routes.clear();
+	omp_destroy_lock(&lock);
+}
+
+void ColumnPool::add(Route *route)
+{
+	//The pool keeps its own copy, generated routes are deleted once added to the node
+	Route *copy = route->clone();
+
+	omp_set_lock(&lock);
+	routes.push_back(copy);
+	if((int)routes.size() > maxSize){
+		delete routes.front();
+		routes.pop_front();
+	}
+	omp_unset_lock(&lock);
+}
+
+int ColumnPool::getImprovingRoutes(Node *node, SubproblemSolver *subproblem, vector<Route*> &improving, int maxRoutes)
+{
+	int found = 0;
+
+	omp_set_lock(&lock);
+	for(unsigned int i=0; i < routes.size() && found < maxRoutes; i++){
+		Route *r = routes[i];
+		if(!subproblem->isRouteAllowed(node, r)) continue;
+
+		double rc = node->verifyRouteCost(r) - node->getRouteUseReducedCost(r->getEquipmentType());
+		if(rc >= -parameters->getEpsilon()) continue;
+
+		Route *copy = r->clone();
+		copy->setCost(rc);
+		improving.push_back(copy);
+		found++;
+	}
+	omp_unset_lock(&lock);
+
+	return found;
+}
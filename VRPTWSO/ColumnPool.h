@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Node.h"
+#include "Route.h"
+
+#include <deque>
+#include <vector>
+#include <omp.h>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+class SubproblemSolver;
+
+/**
+* Routes generated by the workers of the parallel tree search.
+* Before calling the subproblem solver, column generation takes the pool routes that are
+* allowed by the pricing network of the node and have negative reduced cost.
+* When full, the oldest routes are discarded.
+*/
+class ColumnPool
+{
+public:
+	ColumnPool(int size);
+	~ColumnPool();
+
+	void add(Route *route);
+	int getImprovingRoutes(Node *node, SubproblemSolver *subproblem, vector<Route*> &improving, int maxRoutes);
+
+	//GET METHODS
+	int size(){ return routes.size(); }
+
+private:
+	GlobalParameters *parameters;
+	deque<Route*> routes;
+	int maxSize;
+	omp_lock_t lock;
+};
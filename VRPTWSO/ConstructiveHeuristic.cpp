@@ -0,0 +1,788 @@
+#include "ConstructiveHeuristic.h"
+
+#include <iostream>
+#include <algorithm>
+#include <queue>
+#include <time.h>
+
+//Position where a job can be inserted in the route of a machine
+struct InsertionOption
+{
+	int machine;
+	int position;
+	int minTime, maxTime; //start times of the job that keep the route feasible
+	double cost;
+};
+
+//Start time and chosen option (per equipment type) of a job insertion
+struct Insertion
+{
+	int time;
+	double cost;
+	vector<int> options;
+};
+
+class InsertionComparator
+{
+public:
+	bool operator()(const Insertion &i1, const Insertion &i2){
+		if(i1.cost != i2.cost)
+			return i1.cost < i2.cost;
+		return i1.time < i2.time;
+	}
+};
+
+//Order in which jobs are inserted
+enum InsertionOrder
+{
+	ORDER_RELEASE_DATE = 0,
+	ORDER_DUE_DATE,
+	ORDER_WINDOW_WIDTH,
+	NUM_ORDERS
+};
+
+class JobTimeWindowComparator
+{
+public:
+	JobTimeWindowComparator(ProblemData *d, InsertionOrder o) : data(d), order(o){}
+
+	bool operator()(int i, int j){
+		int first1 = data->jobs[i]->getFirstStartTimePeriod(), last1 = data->jobs[i]->getLastStartTimePeriod();
+		int first2 = data->jobs[j]->getFirstStartTimePeriod(), last2 = data->jobs[j]->getLastStartTimePeriod();
+
+		switch(order){
+			case ORDER_DUE_DATE:
+				if(last1 != last2) return last1 < last2;
+				break;
+			case ORDER_WINDOW_WIDTH:
+				if(last1 - first1 != last2 - first2) return (last1 - first1) < (last2 - first2);
+				break;
+			default: //release date order is the tie break below
+				break;
+		}
+
+		if(first1 != first2) return first1 < first2;
+		if(last1 != last2) return last1 < last2;
+		return i < j;
+	}
+
+private:
+	ProblemData *data;
+	InsertionOrder order;
+};
+
+ConstructiveHeuristic::ConstructiveHeuristic(ProblemData *d) : data(d), solutionValue(1e13)
+{
+	parameters = GlobalParameters::getInstance();
+	loadCapacity = vector<int>(data->numEquipments);
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		loadCapacity[eqType] = data->getLoadCapacity(eqType);
+	}
+}
+
+ConstructiveHeuristic::~ConstructiveHeuristic()
+{
+	machineRoutes.clear();
+	startTime.clear();
+}
+
+bool ConstructiveHeuristic::solve()
+{
+	clock_t start = clock();
+
+	vector<vector<vector<int>>> bestRoutes;
+	vector<int> bestTimes;
+	double bestValue = 1e13;
+
+	//Build one solution per insertion order and keep the best one
+	for(int order=0; order < NUM_ORDERS; order++){
+		vector<int> jobOrder;
+		for(int j=1; j < data->numJobs; j++)
+			jobOrder.push_back(j);
+		sort(jobOrder.begin(),jobOrder.end(),JobTimeWindowComparator(data,(InsertionOrder)order));
+
+		if(!construct(jobOrder)) continue;
+
+		//Local search
+		int pass = 0;
+		bool improved = true;
+		while(improved && pass < parameters->getLocalSearchMaxPasses()){
+			improved = false;
+			if(relocate()) improved = true;
+			if(exchange()) improved = true;
+			if(twoOptStar()) improved = true;
+			pass++;
+		}
+		solutionValue = evaluate();
+		cout << "Constructive heuristic: order " << order << " local search value = " << solutionValue << " (" << pass << " passes)" << endl;
+
+		if(solutionValue < bestValue){
+			bestValue = solutionValue;
+			bestRoutes = machineRoutes;
+			bestTimes = startTime;
+		}
+	}
+
+	if(bestValue >= 1e13){
+		cout << "Constructive heuristic: no feasible solution found (" << (double)(clock() - start)/CLOCKS_PER_SEC << "s)" << endl;
+		return false;
+	}
+
+	machineRoutes = bestRoutes;
+	startTime = bestTimes;
+	solutionValue = bestValue;
+	cout << "Constructive heuristic: best value = " << solutionValue << " (" << (double)(clock() - start)/CLOCKS_PER_SEC << "s)" << endl;
+
+	return true;
+}
+
+bool ConstructiveHeuristic::construct(const vector<int> &jobOrder)
+{
+	//Every machine starts with an empty route
+	machineRoutes = vector<vector<vector<int>>>(data->numEquipments);
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		machineRoutes[eqType] = vector<vector<int>>(data->equipments[eqType]->getNumMachines());
+	}
+	startTime = vector<int>(data->numJobs,-1);
+
+	//Jobs that can not be inserted are retried once the others are scheduled
+	vector<int> pending = jobOrder;
+	while(pending.size() > 0){
+		vector<int> failed;
+		vector<int>::const_iterator it = pending.begin();
+		for(; it != pending.end(); it++){
+			if(!insertJob(*it))
+				failed.push_back(*it);
+		}
+
+		if(failed.size() == pending.size()){
+			cout << "Constructive heuristic: job " << failed[0] << " could not be inserted (" << failed.size() << " jobs left)." << endl;
+			return false;
+		}
+		pending = failed;
+	}
+
+	//The ovf formulation requires every machine to leave the depot
+	if(!useAllMachines()){
+		cout << "Constructive heuristic: not enough jobs to use every machine." << endl;
+		return false;
+	}
+
+	solutionValue = evaluate();
+	return true;
+}
+
+bool ConstructiveHeuristic::insertJob(int j)
+{
+	Job *job = data->jobs[j];
+	int first = job->getFirstStartTimePeriod();
+	int last = job->getLastStartTimePeriod();
+
+	//Jobs after the insertion point can be delayed up to their latest start time
+	vector<int> latestTime = getLatestStartTimes();
+
+	//Precedences with the jobs already scheduled
+	for(unsigned int p=0; p < data->predecessors[j].size(); p++){
+		int i = data->predecessors[j][p].first;
+		if(startTime[i] >= 0) first = max(first, startTime[i] + data->predecessors[j][p].second);
+	}
+	for(unsigned int p=0; p < data->successors[j].size(); p++){
+		int k = data->successors[j][p].first;
+		if(startTime[k] >= 0) last = min(last, latestTime[k] - data->successors[j][p].second);
+	}
+	first = job->getNextStartTime(first);
+
+	if(first < 0 || first > last) return false;
+
+	//Get every feasible position for each required equipment type
+	vector<vector<InsertionOption>> options = vector<vector<InsertionOption>>(data->numEquipments);
+	vector<int> candidateTimes;
+	bool required = false;
+
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		if(job->getEquipmentTypeRequired(eqType) <= 0) continue;
+		required = true;
+		Equipment *e = data->equipments[eqType];
+
+		for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+			vector<int> &route = machineRoutes[eqType][m];
+			if(loadCapacity[eqType] > 0 && routeLoad(route) + job->getDemand() > loadCapacity[eqType]) continue;
+
+			for(int p=0; p <= (int)route.size(); p++){
+				int prev = (p > 0)? route[p-1] : 0;
+				int next = (p < (int)route.size())? route[p] : 0;
+
+				InsertionOption option;
+				option.machine = m;
+				option.position = p;
+				option.minTime = job->getNextStartTime(max(first, getStartTime(prev) + data->jobs[prev]->getServiceTime() + (int)e->getTransitionTime(prev,j)));
+				option.maxTime = last;
+				if(next != 0)
+					option.maxTime = min(last, latestTime[next] - job->getServiceTime() - (int)e->getTransitionTime(j,next));
+
+				if(option.minTime < 0 || option.minTime > option.maxTime) continue;
+
+				option.cost = legCost(eqType,prev,j) + legCost(eqType,j,next) - legCost(eqType,prev,next);
+				options[eqType].push_back(option);
+				candidateTimes.push_back(option.minTime);
+			}
+		}
+
+		if(options[eqType].size() == 0) return false;
+	}
+
+	//No machine needed
+	if(!required){
+		startTime[j] = first;
+		return true;
+	}
+
+	sort(candidateTimes.begin(),candidateTimes.end());
+	candidateTimes.erase(unique(candidateTimes.begin(),candidateTimes.end()),candidateTimes.end());
+
+	//Every required equipment type must start serving the job at the same time period
+	vector<Insertion> insertions;
+	vector<int> chosen = vector<int>(data->numEquipments,-1);
+
+	vector<int>::iterator tit = candidateTimes.begin();
+	for(; tit != candidateTimes.end(); tit++){
+		int t = (*tit);
+		double cost = 0;
+		bool feasible = true;
+
+		for(int eqType=0; eqType < data->numEquipments && feasible; eqType++){
+			if(job->getEquipmentTypeRequired(eqType) <= 0) continue;
+
+			chosen[eqType] = -1;
+			for(int o=0; o < (int)options[eqType].size(); o++){
+				InsertionOption &option = options[eqType][o];
+				if(option.minTime > t || option.maxTime < t) continue;
+				if(chosen[eqType] < 0 || option.cost < options[eqType][chosen[eqType]].cost)
+					chosen[eqType] = o;
+			}
+
+			if(chosen[eqType] < 0)
+				feasible = false;
+			else
+				cost += options[eqType][chosen[eqType]].cost;
+		}
+
+		if(feasible){
+			Insertion insertion;
+			insertion.time = t;
+			insertion.cost = cost;
+			insertion.options = chosen;
+			insertions.push_back(insertion);
+		}
+	}
+
+	//Latest start times do not see the cycles an insertion may create, so the cheapest
+	//insertion is confirmed by delaying the following jobs
+	sort(insertions.begin(),insertions.end(),InsertionComparator());
+
+	vector<vector<vector<int>>> oldRoutes = machineRoutes;
+	vector<int> oldTimes = startTime;
+
+	vector<Insertion>::iterator iit = insertions.begin();
+	for(; iit != insertions.end(); iit++){
+		startTime[j] = iit->time;
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			if(job->getEquipmentTypeRequired(eqType) <= 0) continue;
+
+			InsertionOption &option = options[eqType][iit->options[eqType]];
+			vector<int> &route = machineRoutes[eqType][option.machine];
+			route.insert(route.begin() + option.position, j);
+		}
+
+		if(delayStartTimes(j)){
+			advanceStartTimes();
+			return true;
+		}
+
+		machineRoutes = oldRoutes;
+		startTime = oldTimes;
+	}
+
+	return false;
+}
+
+vector<int> ConstructiveHeuristic::getLatestStartTimes()
+{
+	vector<int> latestTime = vector<int>(data->numJobs,0);
+	for(int j=1; j < data->numJobs; j++)
+		latestTime[j] = data->jobs[j]->getLastStartTimePeriod();
+
+	//Relax route precedences until no latest start time changes
+	bool changed = true;
+	while(changed){
+		changed = false;
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			Equipment *e = data->equipments[eqType];
+			for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+				vector<int> &route = machineRoutes[eqType][m];
+				for(int p=(int)route.size()-2; p >= 0; p--){
+					int i = route[p], k = route[p+1];
+					int latest = latestTime[k] - data->jobs[i]->getServiceTime() - (int)e->getTransitionTime(i,k);
+					if(latest < latestTime[i]){
+						latestTime[i] = latest;
+						changed = true;
+					}
+				}
+			}
+		}
+
+		//Scheduled jobs must start before their scheduled successors by precedence
+		for(int i=1; i < data->numJobs; i++){
+			if(startTime[i] < 0) continue;
+			for(unsigned int p=0; p < data->successors[i].size(); p++){
+				int k = data->successors[i][p].first;
+				if(startTime[k] < 0) continue;
+				int latest = latestTime[k] - data->successors[i][p].second;
+				if(latest < latestTime[i]){
+					latestTime[i] = latest;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	return latestTime;
+}
+
+void ConstructiveHeuristic::advanceStartTimes()
+{
+	for(int j=1; j < data->numJobs; j++){
+		if(startTime[j] >= 0)
+			startTime[j] = data->jobs[j]->getFirstStartTimePeriod();
+	}
+
+	//Start every job as soon as its predecessors in all routes allow it
+	bool changed = true;
+	while(changed){
+		changed = false;
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			Equipment *e = data->equipments[eqType];
+			for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+				vector<int> &route = machineRoutes[eqType][m];
+				int prev = 0;
+				for(int p=0; p < (int)route.size(); p++){
+					int k = route[p];
+					int arriveTime = getStartTime(prev) + data->jobs[prev]->getServiceTime() + (int)e->getTransitionTime(prev,k);
+					arriveTime = data->jobs[k]->getNextStartTime(arriveTime);
+					if(arriveTime > startTime[k]){
+						startTime[k] = arriveTime;
+						changed = true;
+					}
+					prev = k;
+				}
+			}
+		}
+
+		//and their predecessors by precedence
+		for(int k=1; k < data->numJobs; k++){
+			if(startTime[k] < 0) continue;
+			for(unsigned int p=0; p < data->predecessors[k].size(); p++){
+				int i = data->predecessors[k][p].first;
+				if(startTime[i] < 0) continue;
+				int arriveTime = data->jobs[k]->getNextStartTime(startTime[i] + data->predecessors[k][p].second);
+				if(arriveTime > startTime[k]){
+					startTime[k] = arriveTime;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+bool ConstructiveHeuristic::delayStartTimes(int j)
+{
+	//Position of every job in the routes of each equipment type
+	vector<vector<pair<int,int>>> position = vector<vector<pair<int,int>>>(data->numEquipments, 
+		vector<pair<int,int>>(data->numJobs, make_pair(-1,-1)));
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+			for(int p=0; p < (int)machineRoutes[eqType][m].size(); p++){
+				position[eqType][machineRoutes[eqType][m][p]] = make_pair(m,p);
+			}
+		}
+	}
+
+	queue<int> myQueue;
+	myQueue.push(j);
+
+	while(myQueue.size() > 0){
+		int i = myQueue.front();
+		myQueue.pop();
+
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			int m = position[eqType][i].first;
+			int p = position[eqType][i].second;
+			if(m < 0 || p+1 >= (int)machineRoutes[eqType][m].size()) continue;
+
+			int k = machineRoutes[eqType][m][p+1];
+			int arriveTime = startTime[i] + data->jobs[i]->getServiceTime() + (int)data->equipments[eqType]->getTransitionTime(i,k);
+			if(arriveTime <= startTime[k]) continue;
+
+			//The inserted job can not be delayed by itself and no job can leave its time window (or start between shifts)
+			arriveTime = data->jobs[k]->getNextStartTime(arriveTime);
+			if(k == j || arriveTime < 0) return false;
+
+			startTime[k] = arriveTime;
+			myQueue.push(k);
+		}
+
+		//Successors by precedence are delayed the same way
+		for(unsigned int p=0; p < data->successors[i].size(); p++){
+			int k = data->successors[i][p].first;
+			if(startTime[k] < 0 || startTime[i] + data->successors[i][p].second <= startTime[k]) continue;
+
+			int arriveTime = data->jobs[k]->getNextStartTime(startTime[i] + data->successors[i][p].second);
+			if(k == j || arriveTime < 0) return false;
+
+			startTime[k] = arriveTime;
+			myQueue.push(k);
+		}
+	}
+
+	return true;
+}
+
+void ConstructiveHeuristic::removeJob(int j)
+{
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+			vector<int> &route = machineRoutes[eqType][m];
+			vector<int>::iterator it = find(route.begin(),route.end(),j);
+			if(it != route.end())
+				route.erase(it);
+		}
+	}
+	startTime[j] = -1;
+	advanceStartTimes();
+}
+
+bool ConstructiveHeuristic::useAllMachines()
+{
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+			if(machineRoutes[eqType][m].size() > 0) continue;
+
+			//Move the cheapest job of a route with at least two jobs to the empty route
+			double bestDelta = 1e13;
+			int bestMachine = -1, bestPosition = -1;
+
+			for(int m2=0; m2 < (int)machineRoutes[eqType].size(); m2++){
+				vector<int> &route = machineRoutes[eqType][m2];
+				if(route.size() < 2) continue;
+
+				for(int p=0; p < (int)route.size(); p++){
+					int j = route[p];
+					int prev = (p > 0)? route[p-1] : 0;
+					int next = (p < (int)route.size()-1)? route[p+1] : 0;
+
+					if(!legFeasible(eqType,0,0,j,startTime[j])) continue;
+					if(!legFeasible(eqType,prev,getStartTime(prev),next,getStartTime(next))) continue;
+
+					double delta = legCost(eqType,0,j) + legCost(eqType,j,0) + legCost(eqType,prev,next)
+						- legCost(eqType,prev,j) - legCost(eqType,j,next);
+					if(delta < bestDelta){
+						bestDelta = delta;
+						bestMachine = m2;
+						bestPosition = p;
+					}
+				}
+			}
+
+			if(bestMachine < 0) return false;
+
+			vector<int> &route = machineRoutes[eqType][bestMachine];
+			machineRoutes[eqType][m].push_back(route[bestPosition]);
+			route.erase(route.begin() + bestPosition);
+		}
+	}
+
+	return true;
+}
+
+bool ConstructiveHeuristic::relocate()
+{
+	bool improved = false;
+
+	for(int j=1; j < data->numJobs; j++){
+		if(startTime[j] < 0) continue;
+
+		//Removing the job must not leave a machine without route
+		bool lastJob = false;
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+				vector<int> &route = machineRoutes[eqType][m];
+				if(route.size() == 1 && route[0] == j) lastJob = true;
+			}
+		}
+		if(lastJob) continue;
+
+		vector<vector<vector<int>>> oldRoutes = machineRoutes;
+		vector<int> oldTimes = startTime;
+		double oldValue = solutionValue;
+
+		//Reinsert the job in its best position (and start time)
+		removeJob(j);
+		if(insertJob(j)){
+			double newValue = evaluate();
+			if(newValue < oldValue - parameters->getEpsilon()){
+				solutionValue = newValue;
+				improved = true;
+				continue;
+			}
+		}
+
+		machineRoutes = oldRoutes;
+		startTime = oldTimes;
+		solutionValue = oldValue;
+	}
+
+	return improved;
+}
+
+bool ConstructiveHeuristic::exchange()
+{
+	bool improved = false;
+
+	//Swap two jobs between routes of the same equipment type, keeping start times
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int m1=0; m1 < (int)machineRoutes[eqType].size(); m1++){
+			for(int m2=m1+1; m2 < (int)machineRoutes[eqType].size(); m2++){
+				vector<int> &r1 = machineRoutes[eqType][m1];
+				vector<int> &r2 = machineRoutes[eqType][m2];
+				int load1 = routeLoad(r1), load2 = routeLoad(r2);
+
+				for(int p1=0; p1 < (int)r1.size(); p1++){
+					for(int p2=0; p2 < (int)r2.size(); p2++){
+						int a = r1[p1], b = r2[p2];
+						int prev1 = (p1 > 0)? r1[p1-1] : 0;
+						int next1 = (p1 < (int)r1.size()-1)? r1[p1+1] : 0;
+						int prev2 = (p2 > 0)? r2[p2-1] : 0;
+						int next2 = (p2 < (int)r2.size()-1)? r2[p2+1] : 0;
+
+						if(!legFeasible(eqType,prev1,getStartTime(prev1),b,startTime[b])) continue;
+						if(!legFeasible(eqType,b,startTime[b],next1,getStartTime(next1))) continue;
+						if(!legFeasible(eqType,prev2,getStartTime(prev2),a,startTime[a])) continue;
+						if(!legFeasible(eqType,a,startTime[a],next2,getStartTime(next2))) continue;
+
+						int demandDelta = data->jobs[b]->getDemand() - data->jobs[a]->getDemand();
+						if(loadCapacity[eqType] > 0 && (load1 + demandDelta > loadCapacity[eqType] || load2 - demandDelta > loadCapacity[eqType])) continue;
+
+						double delta = legCost(eqType,prev1,b) + legCost(eqType,b,next1) + legCost(eqType,prev2,a) + legCost(eqType,a,next2)
+							- legCost(eqType,prev1,a) - legCost(eqType,a,next1) - legCost(eqType,prev2,b) - legCost(eqType,b,next2);
+
+						if(delta < -parameters->getEpsilon()){
+							r1[p1] = b;
+							r2[p2] = a;
+							load1 += demandDelta;
+							load2 -= demandDelta;
+							solutionValue += delta;
+							improved = true;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return improved;
+}
+
+bool ConstructiveHeuristic::twoOptStar()
+{
+	bool improved = false;
+
+	//Exchange the tails of two routes of the same equipment type, keeping start times
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int m1=0; m1 < (int)machineRoutes[eqType].size(); m1++){
+			for(int m2=m1+1; m2 < (int)machineRoutes[eqType].size(); m2++){
+				vector<int> &r1 = machineRoutes[eqType][m1];
+				vector<int> &r2 = machineRoutes[eqType][m2];
+
+				bool changed = true;
+				while(changed){
+					changed = false;
+					int len1 = r1.size();
+					int len2 = r2.size();
+
+					//Demand of the first p jobs of each route
+					vector<int> head1(len1 + 1, 0), head2(len2 + 1, 0);
+					for(int p=0; p < len1; p++) head1[p+1] = head1[p] + data->jobs[r1[p]]->getDemand();
+					for(int p=0; p < len2; p++) head2[p+1] = head2[p] + data->jobs[r2[p]]->getDemand();
+
+					for(int p1=0; p1 <= len1 && !changed; p1++){
+						for(int p2=0; p2 <= len2 && !changed; p2++){
+							if((p1 == 0 && p2 == 0) || (p1 == len1 && p2 == len2)) continue;
+							//Both routes must keep at least one job
+							if(p1 + len2 - p2 < 1 || p2 + len1 - p1 < 1) continue;
+
+							int a1 = (p1 > 0)? r1[p1-1] : 0;
+							int b1 = (p1 < len1)? r1[p1] : 0;
+							int a2 = (p2 > 0)? r2[p2-1] : 0;
+							int b2 = (p2 < len2)? r2[p2] : 0;
+
+							if(!legFeasible(eqType,a1,getStartTime(a1),b2,getStartTime(b2))) continue;
+							if(!legFeasible(eqType,a2,getStartTime(a2),b1,getStartTime(b1))) continue;
+							if(loadCapacity[eqType] > 0 && (head1[p1] + head2[len2] - head2[p2] > loadCapacity[eqType] 
+								|| head2[p2] + head1[len1] - head1[p1] > loadCapacity[eqType])) continue;
+
+							double delta = legCost(eqType,a1,b2) + legCost(eqType,a2,b1) - legCost(eqType,a1,b1) - legCost(eqType,a2,b2);
+
+							if(delta < -parameters->getEpsilon()){
+								vector<int> n1(r1.begin(),r1.begin()+p1);
+								n1.insert(n1.end(),r2.begin()+p2,r2.end());
+								vector<int> n2(r2.begin(),r2.begin()+p2);
+								n2.insert(n2.end(),r1.begin()+p1,r1.end());
+								r1 = n1;
+								r2 = n2;
+
+								solutionValue += delta;
+								improved = true;
+								changed = true;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return improved;
+}
+
+double ConstructiveHeuristic::legCost(int eqType, int i, int j)
+{
+	if(i == 0 && j == 0) return 0.0;
+	return data->equipments[eqType]->getNotRoundedTransitionTime(i,j);
+}
+
+bool ConstructiveHeuristic::legFeasible(int eqType, int i, int iTime, int j, int jTime)
+{
+	//Time windows were shrinked to allow the return to the depot
+	if(j == 0) return true;
+
+	int arriveTime = iTime + data->jobs[i]->getServiceTime() + (int)data->equipments[eqType]->getTransitionTime(i,j);
+	return arriveTime <= jTime;
+}
+
+double ConstructiveHeuristic::routeCost(int eqType, const vector<int> &route)
+{
+	double cost = 0.0;
+	int prev = 0;
+
+	vector<int>::const_iterator it = route.begin();
+	for(; it != route.end(); it++){
+		//With the work shift decomposition the machine goes back to the depot between shifts
+		if(prev != 0 && data->getShiftEnd(getStartTime(prev)) <= getStartTime(*it))
+			cost += legCost(eqType,prev,0) + legCost(eqType,0,*it);
+		else
+			cost += legCost(eqType,prev,*it);
+		prev = (*it);
+	}
+	cost += legCost(eqType,prev,0);
+
+	return cost;
+}
+
+int ConstructiveHeuristic::routeLoad(const vector<int> &route)
+{
+	int load = 0;
+	for(unsigned int p=0; p < route.size(); p++){
+		load += data->jobs[route[p]]->getDemand();
+	}
+	return load;
+}
+
+double ConstructiveHeuristic::evaluate()
+{
+	double value = 0.0;
+
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+			value += routeCost(eqType,machineRoutes[eqType][m]);
+		}
+	}
+
+	return value;
+}
+
+Solution *ConstructiveHeuristic::getSolution()
+{
+	Solution *solution = new Solution();
+
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		Equipment *e = data->equipments[eqType];
+		for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+			vector<int> &route = machineRoutes[eqType][m];
+			if(route.size() == 0) continue;
+
+			int prev = 0;
+			int depotTime = 0;
+
+			for(int p=0; p <= (int)route.size(); p++){
+				int next = (p < (int)route.size())? route[p] : 0;
+
+				//Back to the depot at the end of the shift of prev (the horizon without the work shift decomposition)
+				if(prev != 0 && (next == 0 || data->getShiftEnd(getStartTime(prev)) <= getStartTime(next))){
+					depotTime = data->getShiftEnd(getStartTime(prev));
+					solution->addEdge(prev,0,getStartTime(prev),depotTime,eqType);
+					prev = 0;
+				}
+
+				if(prev == 0){
+					//Wait at the depot for the shift of next
+					int departure = (next == 0)? data->horizonLength : data->getShiftStart(getStartTime(next));
+					if(depotTime < departure) solution->addEdge(0,0,depotTime,departure,eqType);
+					if(next == 0) break;
+
+					int arriveTime = departure + data->jobs[0]->getServiceTime() + (int)e->getTransitionTime(0,next);
+					solution->addEdge(0,next,departure,arriveTime,eqType);
+				}else{
+					int arriveTime = getStartTime(prev) + data->jobs[prev]->getServiceTime() + (int)e->getTransitionTime(prev,next);
+					solution->addEdge(prev,next,getStartTime(prev),arriveTime,eqType);
+				}
+				prev = next;
+			}
+		}
+	}
+	solution->setSolutionValue(solutionValue);
+
+	return solution;
+}
+
+vector<Route*> ConstructiveHeuristic::getRoutes()
+{
+	vector<Route*> routes;
+
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int m=0; m < (int)machineRoutes[eqType].size(); m++){
+			vector<int> &route = machineRoutes[eqType][m];
+			if(route.size() == 0) continue;
+
+			Route *myRoute = new Route(eqType);
+			myRoute->setCost(routeCost(eqType,route));
+
+			//Edges are stored from the end of the route to the depot. The depot is left at the start of
+			//the shift of the next job and visited again between shifts (work shift decomposition)
+			int next = 0;
+			for(int p=route.size()-1; p >= -1; p--){
+				int prev = (p >= 0)? route[p] : 0;
+				if(prev != 0 && next != 0 && data->getShiftEnd(getStartTime(prev)) <= getStartTime(next)){
+					myRoute->edges.push_back(new Edge(0,next,data->getShiftStart(getStartTime(next))));
+					myRoute->edges.push_back(new Edge(prev,0,getStartTime(prev)));
+				}else{
+					int time = (prev == 0)? data->getShiftStart(getStartTime(next)) : getStartTime(prev);
+					myRoute->edges.push_back(new Edge(prev,next,time));
+				}
+				next = prev;
+			}
+			routes.push_back(myRoute);
+		}
+	}
+
+	return routes;
+}
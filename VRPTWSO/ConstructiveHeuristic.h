@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Data.h"
+#include "Route.h"
+#include "Solution.h"
+#include "GlobalParameters.h"
+
+#include <vector>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+/**
+* Builds a first integer feasible solution (ZInc) without solving the ovf MIP.
+* Jobs are inserted one by one at the cheapest time window feasible position of one
+* machine of every required equipment type, all of them starting at the same time period
+* (synchronization). The schedule is then improved by relocate, exchange and 2-opt* moves.
+*/
+class ConstructiveHeuristic
+{
+public:
+	ConstructiveHeuristic(ProblemData *d);
+	~ConstructiveHeuristic();
+
+	bool solve();
+
+	//GET METHODS
+	double getSolutionValue(){ return solutionValue; }
+	Solution *getSolution();
+	vector<Route*> getRoutes();
+
+private:
+	ProblemData *data;
+	GlobalParameters *parameters;
+
+	//Jobs visited by each machine ([eqType][machine]), ordered by start time
+	vector<vector<vector<int>>> machineRoutes;
+	//Start time period of each job (-1 if not scheduled)
+	vector<int> startTime;
+	double solutionValue;
+	//Capacity of each equipment type (0 = no load resource), a machine carries the demand of its whole route
+	vector<int> loadCapacity;
+
+	//Insertion
+	bool construct(const vector<int> &jobOrder);
+	bool insertJob(int j);
+	vector<int> getLatestStartTimes();
+	bool delayStartTimes(int j);
+	void advanceStartTimes();
+	void removeJob(int j);
+	bool useAllMachines();
+
+	//Local search
+	bool relocate();
+	bool exchange();
+	bool twoOptStar();
+
+	//Evaluation
+	int getStartTime(int j){ return (j == 0)? 0 : startTime[j]; }
+	double legCost(int eqType, int i, int j);
+	bool legFeasible(int eqType, int i, int iTime, int j, int jTime);
+	double routeCost(int eqType, const vector<int> &route);
+	int routeLoad(const vector<int> &route);
+	double evaluate();
+};
@@ -0,0 +1,230 @@
+#include "CutPool.h"
+#include "Node.h"
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+//CUT
+string Cut::getKey() const
+{
+	vector<pair<int,int>> sorted = arcs;
+	sort(sorted.begin(), sorted.end());
+
+	stringstream s;
+	s << family << "," << eqType << "," << sense << rhs << ":";
+	for(unsigned int k=0; k < sorted.size(); k++){
+		s << sorted[k].first << "," << sorted[k].second << ";";
+	}
+	for(unsigned int k=0; k < jobs.size(); k++){
+		s << jobs[k] << ";";
+	}
+	//A cut re-separated with a larger memory is a different (stronger) cut
+	s << "|";
+	for(unsigned int k=0; k < memory.size(); k++){
+		s << memory[k] << ";";
+	}
+	return s.str();
+}
+
+string Cut::getName(int id)
+{
+	stringstream s;
+	s << "Cut_" << id;
+	return s.str();
+}
+
+int Cut::getRouteCoefficient(const vector<int> &visits) const
+{
+	//Limited memory: the visits to the cut jobs are only paired while the route stays in the memory jobs
+	int coefficient = 0;
+	bool odd = false;
+	for(unsigned int k=0; k < visits.size(); k++){
+		if(find(memory.begin(), memory.end(), visits[k]) == memory.end()){
+			odd = false;
+		}else if(find(jobs.begin(), jobs.end(), visits[k]) != jobs.end()){
+			if(odd) coefficient++;
+			odd = !odd;
+		}
+	}
+	return coefficient;
+}
+
+double Cut::getViolation(const vector<vector<vector<double>>> &flows) const
+{
+	double lhs = 0.0;
+	for(unsigned int k=0; k < arcs.size(); k++){
+		lhs += flows[eqType][arcs[k].first][arcs[k].second];
+	}
+	return (sense == GRB_GREATER_EQUAL)? rhs - lhs : lhs - rhs;
+}
+
+//CUT POOL
+CutPool::CutPool() : rootBound(-1e13)
+{
+	parameters = GlobalParameters::getInstance();
+	cuts = vector<Cut*>();
+	separatedCuts = vector<int>(NUM_CUT_FAMILIES, 0);
+	separatingNodes = vector<int>(NUM_CUT_FAMILIES, 0);
+	rootGain = vector<double>(NUM_CUT_FAMILIES, 0.0);
+	omp_init_lock(&lock);
+}
+
+CutPool::~CutPool()
+{
+	for(unsigned int i=0; i < cuts.size(); i++){
+		delete cuts[i];
+	}
+	cuts.clear();
+	keys.clear();
+	omp_destroy_lock(&lock);
+}
+
+int CutPool::add(Cut *cut)
+{
+	//The pool owns the cut, a repeated cut is discarded and the id of the first one is returned
+	bool repeated = false;
+
+	omp_set_lock(&lock);
+	pair<map<string,int>::iterator,bool> entry = keys.insert(make_pair(cut->getKey(), (int)cuts.size()));
+	int id = entry.first->second;
+	if(entry.second){
+		cut->setId(id);
+		cuts.push_back(cut);
+	}else{
+		repeated = true;
+	}
+	omp_unset_lock(&lock);
+
+	if(repeated) delete cut;
+	return id;
+}
+
+Cut *CutPool::getCut(int id)
+{
+	omp_set_lock(&lock);
+	Cut *cut = (id >= 0 && id < (int)cuts.size())? cuts[id] : nullptr;
+	omp_unset_lock(&lock);
+	return cut;
+}
+
+int CutPool::getViolatedCuts(Node *node, const vector<vector<vector<double>>> &flows, vector<Cut*> &violated, int maxCuts)
+{
+	int found = 0;
+	double minViolation = 100 * parameters->getEpsilon();
+
+	omp_set_lock(&lock);
+	for(unsigned int i=0; i < cuts.size() && found < maxCuts; i++){
+		if(!cuts[i]->isRobust() || node->hasCut(cuts[i]->getId())) continue;
+		if(cuts[i]->getViolation(flows) <= minViolation) continue;
+
+		violated.push_back(cuts[i]);
+		found++;
+	}
+	omp_unset_lock(&lock);
+
+	return found;
+}
+
+void CutPool::write(ostream &out)
+{
+	omp_set_lock(&lock);
+
+	int numCuts = cuts.size();
+	out.write((char*)&numCuts, sizeof(int));
+	for(int i=0; i < numCuts; i++){
+		int fields[4] = {cuts[i]->getFamily(), cuts[i]->getEquipmentType(), cuts[i]->getSense(), (int)cuts[i]->arcs.size()};
+		double rhs = cuts[i]->getRhs();
+		out.write((char*)fields, 4 * sizeof(int));
+		out.write((char*)&rhs, sizeof(double));
+
+		for(unsigned int k=0; k < cuts[i]->arcs.size(); k++){
+			int arc[2] = {cuts[i]->arcs[k].first, cuts[i]->arcs[k].second};
+			out.write((char*)arc, 2 * sizeof(int));
+		}
+		writeVector(out, cuts[i]->jobs);
+		writeVector(out, cuts[i]->memory);
+	}
+
+	omp_unset_lock(&lock);
+}
+
+void CutPool::read(istream &in)
+{
+	//Cuts are read in id order, so the ids of the node records are kept
+	int numCuts;
+	in.read((char*)&numCuts, sizeof(int));
+
+	for(int i=0; i < numCuts; i++){
+		int fields[4];
+		double rhs;
+		in.read((char*)fields, 4 * sizeof(int));
+		in.read((char*)&rhs, sizeof(double));
+
+		Cut *cut = new Cut((CutFamily)fields[0], fields[1], rhs, (char)fields[2]);
+		for(int k=0; k < fields[3]; k++){
+			int arc[2];
+			in.read((char*)arc, 2 * sizeof(int));
+			cut->arcs.push_back(make_pair(arc[0], arc[1]));
+		}
+		cut->jobs = readVector(in);
+		cut->memory = readVector(in);
+		add(cut);
+	}
+}
+
+void CutPool::writeVector(ostream &out, const vector<int> &values)
+{
+	int size = values.size();
+	out.write((char*)&size, sizeof(int));
+	if(size > 0) out.write((char*)&values[0], size * sizeof(int));
+}
+
+vector<int> CutPool::readVector(istream &in)
+{
+	int size;
+	in.read((char*)&size, sizeof(int));
+
+	vector<int> values = vector<int>(size);
+	if(size > 0) in.read((char*)&values[0], size * sizeof(int));
+	return values;
+}
+
+void CutPool::addNodeStatistics(CutFamily family, int numCuts)
+{
+	omp_set_lock(&lock);
+	separatedCuts[family] += numCuts;
+	separatingNodes[family]++;
+	omp_unset_lock(&lock);
+}
+
+void CutPool::addRootGain(CutFamily family, double gain)
+{
+	omp_set_lock(&lock);
+	rootGain[family] += gain;
+	omp_unset_lock(&lock);
+}
+
+void CutPool::setRootBound(double bound)
+{
+	//Bound of the root before its first cut
+	omp_set_lock(&lock);
+	if(rootBound <= -1e13) rootBound = bound;
+	omp_unset_lock(&lock);
+}
+
+void CutPool::printStatistics(double incumbent)
+{
+	string familyNames[NUM_CUT_FAMILIES] = {"Capacity", "Tournament", "Subset row"};
+	double rootGap = incumbent - rootBound;
+
+	for(int f=0; f < NUM_CUT_FAMILIES; f++){
+		cout << left << setw(12) << familyNames[f] << " cuts: " << setw(6) << separatedCuts[f] << " nodes: " << setw(6) << separatingNodes[f];
+		cout << " root gain: " << setw(10) << rootGain[f];
+		if(rootBound > -1e13 && incumbent < 1e13 && rootGap > parameters->getEpsilon()){
+			cout << " root gap closed: " << 100.0 * rootGain[f] / rootGap << "%";
+		}
+		cout << endl;
+	}
+	cout << "Cuts in the pool: " << cuts.size() << endl;
+}
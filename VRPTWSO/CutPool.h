@@ -0,0 +1,117 @@
+#pragma once
+
+#include "gurobi_c++.h"
+#include "GlobalParameters.h"
+
+#include <vector>
+#include <string>
+#include <map>
+#include <iostream>
+#include <omp.h>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+class Node;
+
+//Families of robust cuts (see CutSeparator)
+enum CutFamily
+{
+	CUT_CAPACITY = 0,	//rounded capacity cuts over the flow entering a set of jobs
+	CUT_TOURNAMENT,		//time window infeasible job triples
+	CUT_SUBSET_ROW,		//3 job subset row cuts over the lambda variables (not robust)
+	NUM_CUT_FAMILIES
+};
+
+/**
+* Robust cut over the x arc variables of the explicit master: the flow of each job pair
+* (summed over its time copies) of one equipment type. Its dual is projected by the explicit
+* master constraints onto the arc reduced costs, so pricing does not change.
+* Subset row cuts are over the lambda variables of one equipment type instead: a route has coefficient
+* floor(visits to the 3 jobs / 2), counting again from zero whenever it leaves the memory jobs of the cut
+* (limited memory). Their duals are paid by the labels of the pricing, which keep one state bit per cut.
+*/
+class Cut
+{
+public:
+	Cut(CutFamily f, int e, double r, char s) : id(-1), family(f), eqType(e), rhs(r), sense(s) {}
+
+	//Job pairs of the cut (all with coefficient 1)
+	vector<pair<int,int>> arcs;
+	//Subset row cuts: jobs of the cut and jobs of its memory (including the cut jobs)
+	vector<int> jobs;
+	vector<int> memory;
+
+	//GET METHODS
+	int getId() const { return id; }
+	CutFamily getFamily() const { return family; }
+	int getEquipmentType() const { return eqType; }
+	double getRhs() const { return rhs; }
+	char getSense() const { return sense; }
+	string getKey() const;
+	static string getName(int id);
+	bool isRobust() const { return family != CUT_SUBSET_ROW; }
+	int getRouteCoefficient(const vector<int> &visits) const;
+
+	//SET METHODS
+	void setId(int i){ id = i; }
+
+	double getViolation(const vector<vector<vector<double>>> &flows) const;
+
+private:
+	int id;
+	CutFamily family;
+	int eqType;
+	double rhs;
+	char sense;
+};
+
+/**
+* All the cuts separated during the search, valid in every node.
+* Nodes keep in their model only the cuts that were recently binding (see Node::ageCuts). The robust
+* cuts dropped by a node are checked again here before separating new ones.
+*/
+class CutPool
+{
+public:
+	CutPool();
+	~CutPool();
+
+	int add(Cut *cut);
+	Cut *getCut(int id);
+	int getViolatedCuts(Node *node, const vector<vector<vector<double>>> &flows, vector<Cut*> &violated, int maxCuts);
+
+	//Checkpoints
+	void write(ostream &out);
+	void read(istream &in);
+
+	//Statistics by family: cuts added, nodes where they were added and bound gained at the root
+	void addNodeStatistics(CutFamily family, int cuts);
+	void addRootGain(CutFamily family, double gain);
+	void setRootBound(double bound);
+	void printStatistics(double incumbent);
+
+	//GET METHODS
+	int size(){ return cuts.size(); }
+
+private:
+	GlobalParameters *parameters;
+	vector<Cut*> cuts;
+	map<string,int> keys;
+	omp_lock_t lock;
+
+	vector<int> separatedCuts;
+	vector<int> separatingNodes;
+	vector<double> rootGain;
+	double rootBound;
+
+	void writeVector(ostream &out, const vector<int> &values);
+	vector<int> readVector(istream &in);
+};
@@ -0,0 +1,238 @@
+#include "CutSeparator.h"
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <set>
+
+CutSeparator::CutSeparator(ProblemData *d) : data(d)
+{
+	parameters = GlobalParameters::getInstance();
+	minViolation = 100 * parameters->getEpsilon();
+
+	int n = data->numJobs;
+	jobsByEquipment = vector<vector<int>>(data->numEquipments);
+	infeasibleTriples = vector<vector<Triple>>(data->numEquipments);
+
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(int j=1; j < n; j++){
+			if(data->jobs[j]->getEquipmentTypeRequired(eqType)) jobsByEquipment[eqType].push_back(j);
+		}
+
+		//Earliest arrival at dJob coming from sJob and latest departure from sJob towards dJob
+		vector<vector<int>> earliestArrival = vector<vector<int>>(n, vector<int>(n, INT_MAX));
+		vector<vector<int>> latestDeparture = vector<vector<int>>(n, vector<int>(n, -1));
+		set<Vertex*,VertexComparator>::iterator vit = data->vertexSet.begin();
+		for(; vit != data->vertexSet.end(); vit++){
+			Vertex *o = (*vit);
+			vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				int dJob = adjacenceList[k]->getJob();
+				if(dJob == o->getJob()) continue;
+				earliestArrival[o->getJob()][dJob] = min(earliestArrival[o->getJob()][dJob], adjacenceList[k]->getTime());
+				latestDeparture[o->getJob()][dJob] = max(latestDeparture[o->getJob()][dJob], o->getTime());
+			}
+		}
+
+		//Arriving at j from i after the last departure from j to l
+		vector<int> &jobs = jobsByEquipment[eqType];
+		for(unsigned int a=0; a < jobs.size(); a++){
+			for(unsigned int b=0; b < jobs.size(); b++){
+				if(a == b || earliestArrival[jobs[a]][jobs[b]] == INT_MAX) continue;
+				for(unsigned int c=0; c < jobs.size(); c++){
+					if(c == a || c == b || latestDeparture[jobs[b]][jobs[c]] < 0) continue;
+					if(earliestArrival[jobs[a]][jobs[b]] > latestDeparture[jobs[b]][jobs[c]]){
+						Triple t = {jobs[a], jobs[b], jobs[c]};
+						infeasibleTriples[eqType].push_back(t);
+					}
+				}
+			}
+		}
+	}
+}
+
+CutSeparator::~CutSeparator()
+{
+	infeasibleTriples.clear();
+	jobsByEquipment.clear();
+}
+
+int CutSeparator::separateCapacityCuts(const vector<vector<vector<double>>> &flows, vector<Cut*> &cuts, int maxCuts)
+{
+	int found = 0;
+	int n = data->numJobs;
+
+	for(int eqType=0; eqType < data->numEquipments && found < maxCuts; eqType++){
+		int capacity = data->equipments[eqType]->getCapacity();
+		if(capacity <= 0) continue;
+
+		const vector<vector<double>> &f = flows[eqType];
+		vector<int> &jobs = jobsByEquipment[eqType];
+
+		for(unsigned int s=0; s < jobs.size() && found < maxCuts; s++){
+			//Grow S from jobs[s], adding the job most connected to it
+			vector<bool> inSet = vector<bool>(n, false);
+			vector<double> connection = vector<double>(n, 0.0);
+			int demand = 0;
+			double inflow = 0.0;
+
+			int v = jobs[s];
+			for(unsigned int size=1; size <= jobs.size() && v >= 0; size++){
+				//Flow entering S once v is added
+				for(int i=0; i < n; i++){
+					if(inSet[i]) inflow -= f[v][i];
+					else if(i != v) inflow += f[i][v];
+				}
+				inSet[v] = true;
+				demand += data->jobs[v]->getDemand();
+				for(int i=0; i < n; i++){
+					connection[i] += f[i][v] + f[v][i];
+				}
+
+				int required = (demand + capacity - 1) / capacity;
+				if(required - inflow > minViolation){
+					Cut *cut = new Cut(CUT_CAPACITY, eqType, required, GRB_GREATER_EQUAL);
+					for(int i=0; i < n; i++){
+						if(inSet[i] || (i != 0 && !data->jobs[i]->getEquipmentTypeRequired(eqType))) continue;
+						for(int j=1; j < n; j++){
+							if(inSet[j]) cut->arcs.push_back(make_pair(i, j));
+						}
+					}
+					cuts.push_back(cut);
+					found++;
+					break;
+				}
+
+				v = -1;
+				double best = parameters->getEpsilon();
+				for(unsigned int k=0; k < jobs.size(); k++){
+					if(!inSet[jobs[k]] && connection[jobs[k]] > best){
+						best = connection[jobs[k]];
+						v = jobs[k];
+					}
+				}
+			}
+		}
+	}
+
+	return found;
+}
+
+int CutSeparator::separateTournamentCuts(const vector<vector<vector<double>>> &flows, vector<Cut*> &cuts, int maxCuts)
+{
+	//Most violated first
+	vector<pair<double,Cut*>> violated;
+
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		const vector<vector<double>> &f = flows[eqType];
+		vector<Triple> &triples = infeasibleTriples[eqType];
+
+		for(unsigned int k=0; k < triples.size(); k++){
+			Triple &t = triples[k];
+			double lhs = f[t.i][t.j] + f[t.j][t.l] + f[t.i][t.l];
+			if(lhs - 1.0 <= minViolation) continue;
+
+			Cut *cut = new Cut(CUT_TOURNAMENT, eqType, 1.0, GRB_LESS_EQUAL);
+			cut->arcs.push_back(make_pair(t.i, t.j));
+			cut->arcs.push_back(make_pair(t.j, t.l));
+			cut->arcs.push_back(make_pair(t.i, t.l));
+			violated.push_back(make_pair(lhs - 1.0, cut));
+		}
+	}
+
+	sort(violated.rbegin(), violated.rend());
+	int found = 0;
+	for(unsigned int k=0; k < violated.size(); k++){
+		if(found < maxCuts){
+			cuts.push_back(violated[k].second);
+			found++;
+		}else{
+			delete violated[k].second;
+		}
+	}
+
+	return found;
+}
+
+int CutSeparator::separateSubsetRowCuts(int eqType, const vector<pair<double,vector<int>>> &routes, vector<Cut*> &cuts, int maxCuts)
+{
+	int n = data->numJobs;
+	vector<int> &jobs = jobsByEquipment[eqType];
+
+	//Left hand side of the triples (a < b < c) with a route visiting two of its jobs
+	map<vector<int>,double> lhs;
+	for(unsigned int r=0; r < routes.size(); r++){
+		const vector<int> &visits = routes[r].second;
+		vector<int> count = vector<int>(n, 0);
+		for(unsigned int k=0; k < visits.size(); k++){
+			count[visits[k]]++;
+		}
+
+		//Triples with two different jobs of the route
+		vector<int> distinct;
+		for(int j=1; j < n; j++){
+			if(count[j] > 0) distinct.push_back(j);
+		}
+		set<vector<int>> triples;
+		for(unsigned int a=0; a < distinct.size(); a++){
+			for(unsigned int b=a+1; b < distinct.size(); b++){
+				for(unsigned int c=0; c < jobs.size(); c++){
+					if(jobs[c] == distinct[a] || jobs[c] == distinct[b]) continue;
+					vector<int> t(3);
+					t[0] = distinct[a]; t[1] = distinct[b]; t[2] = jobs[c];
+					sort(t.begin(), t.end());
+					triples.insert(t);
+				}
+			}
+		}
+
+		set<vector<int>>::iterator tit = triples.begin();
+		for(; tit != triples.end(); tit++){
+			const vector<int> &t = (*tit);
+			int coefficient = (count[t[0]] + count[t[1]] + count[t[2]]) / 2;
+			lhs[t] += coefficient * routes[r].first;
+		}
+	}
+
+	//Most violated first
+	vector<pair<double,vector<int>>> violated;
+	map<vector<int>,double>::iterator it = lhs.begin();
+	for(; it != lhs.end(); it++){
+		if(it->second - 1.0 > minViolation) violated.push_back(make_pair(it->second - 1.0, it->first));
+	}
+	sort(violated.rbegin(), violated.rend());
+
+	int found = 0;
+	for(unsigned int k=0; k < violated.size() && found < maxCuts; k++){
+		Cut *cut = new Cut(CUT_SUBSET_ROW, eqType, 1.0, GRB_LESS_EQUAL);
+		cut->jobs = violated[k].second;
+
+		//Memory: jobs between the first and the last visit to the cut jobs of the routes visiting them twice,
+		//so the limited memory coefficient of the routes of the solution is floor(visits / 2)
+		vector<bool> inMemory = vector<bool>(n, false);
+		for(unsigned int r=0; r < routes.size(); r++){
+			const vector<int> &visits = routes[r].second;
+
+			int first = -1, last = -1, count = 0;
+			for(unsigned int p=0; p < visits.size(); p++){
+				if(find(cut->jobs.begin(), cut->jobs.end(), visits[p]) == cut->jobs.end()) continue;
+				if(first < 0) first = p;
+				last = p;
+				count++;
+			}
+			if(count < 2) continue;
+
+			for(int p=first; p <= last; p++){
+				inMemory[visits[p]] = true;
+			}
+		}
+		for(int j=1; j < n; j++){
+			if(inMemory[j] || find(cut->jobs.begin(), cut->jobs.end(), j) != cut->jobs.end()) cut->memory.push_back(j);
+		}
+
+		cuts.push_back(cut);
+		found++;
+	}
+
+	return found;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Data.h"
+#include "CutPool.h"
+#include "GlobalParameters.h"
+
+#include <vector>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+/**
+* Separation of robust cuts on the job pair flows of a node ([eqType][sJob][dJob]).
+* Rounded capacity cuts: the flow entering a set S of jobs of a capacitated equipment type is at least
+* ceil(demand(S) / capacity). Sets are grown greedily from every job.
+* Tournament cuts: if no machine can serve i, j and l in this order within their time windows,
+* x(i,j) + x(j,l) + x(i,l) <= 1, since every job is entered and left once per equipment type.
+* Subset row cuts are separated on the routes of the lambda solution (value, visited jobs in order) by
+* enumerating the job triples visited at least twice by some route. Their memory is made of the jobs
+* visited between the cut jobs by those routes.
+*/
+class CutSeparator
+{
+public:
+	CutSeparator(ProblemData *d);
+	~CutSeparator();
+
+	int separateCapacityCuts(const vector<vector<vector<double>>> &flows, vector<Cut*> &cuts, int maxCuts);
+	int separateTournamentCuts(const vector<vector<vector<double>>> &flows, vector<Cut*> &cuts, int maxCuts);
+	int separateSubsetRowCuts(int eqType, const vector<pair<double,vector<int>>> &routes, vector<Cut*> &cuts, int maxCuts);
+
+private:
+	ProblemData *data;
+	GlobalParameters *parameters;
+	double minViolation;
+
+	//Job triples (i, j, l) that can not be served in this order by one machine ([eqType])
+	struct Triple
+	{
+		int i, j, l;
+	};
+	vector<vector<Triple>> infeasibleTriples;
+
+	//Jobs that require each equipment type
+	vector<vector<int>> jobsByEquipment;
+};
@@ -1,159 +1,388 @@
-#include "Data.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <math.h>
-
-void ProblemData::readData(const std::string & fileName)
-{
-	ifstream in;
-	in.open(fileName.c_str());
-	if (!in)
-	{
-		std::cout << "Instance does not exist." << endl;
-		exit(EXIT_FAILURE);
-	}
-
-	string line, str;
-	string space;
-	int sw = 0;
-	int con = 0;
-	int precCounter = 0;
-
-	std::vector<Location*> locations;
-
-	while (getline(in, line))
-	{
-		if (line.find('#') != string::npos) //Header line
-		{ 
-			sw++;
-			continue;
-		}
-
-		stringstream is(line);
-		switch (sw)
-		{
-		case 1:
-			is >> numEquipments;
-			equipments.resize(numEquipments);
-			sw++;
-			break;
-		case 2:
-			//types of equipment
-			int equipmentId, machineQty, maxTransitionTime, capacity;
-			is >> equipmentId >> machineQty >> maxTransitionTime >> capacity;
-			equipments[equipmentId] = new Equipment(equipmentId, machineQty, maxTransitionTime,	capacity);
-			break;
-		case 3:
-			is >> numLocations;
-			locations.resize(numLocations);
-			sw++;
-			break;
-		case 4:
-			//locations
-			int locationId, x, y;
-			is >> locationId >> x >> y;
-			locations[locationId] = new Location(locationId, x, y);
-			break;
-		case 5:
-			//total workshifts
-			is >> horizonLength >> numWorkShifts;
-			workShiftLength = horizonLength / numWorkShifts;
-			if (workShiftLength * numWorkShifts != horizonLength)
-				horizonLength = workShiftLength * numWorkShifts;
-			break;
-		case 6:
-			//total Jobs
-			is >> numJobs;
-			jobs.resize(numJobs); 
-			sw++;
-			break;
-		case 7:
-			int jobId, weight, serviceTime, demand, numWS, locId;
-			std::vector<bool> workShifts(numWorkShifts, false);
-			std::vector<int> readyDates(numWorkShifts, 0);
-			std::vector<int> dueDates(numWorkShifts, 0);
-			std::vector<int> machineTypes(numEquipments);
-
-			is >> jobId >> weight >> serviceTime >> locId >> demand;
-			jobs[jobId] = new Job(jobId, weight, serviceTime, locId, demand);
-
-			for (int j = 0; j < numEquipments; j++)
-				is >> machineTypes[j];
-			jobs[jobId]->setEquipmentTypes(machineTypes);
-
-			is >> numWS;
-			for (int sh = 0; sh < numWS; sh++)
-			{
-				int id, rel, due;
-				is >> id >> rel >> due;
-				workShifts[id] = true;
-				readyDates[id] = rel;
-				dueDates[id] = due;
-			}
-			jobs[jobId]->setWorkShifts(workShifts);
-			jobs[jobId]->setReadyDates(readyDates);
-			jobs[jobId]->setDueDates(dueDates);
-			break;
-		}
-	}
-
-	/// Calculate distances between locations
-	std::vector<std::vector<double>> locDistances(numLocations,std::vector<double>(numLocations, 0.0));
-	Location *origLocPtr, *destLocPtr;
-	double maxLocDistance = 0;
-	for (int origId = 0; origId < numLocations - 1; origId++)
-	{
-		for (int destId = origId + 1; destId < numLocations; destId++)
-		{
-			origLocPtr = locations[origId];
-			destLocPtr = locations[destId];
-			double distance = sqrt(
-				pow(origLocPtr->getX() - destLocPtr->getX(), 2.0)
-				+ pow(origLocPtr->getY() - destLocPtr->getY(), 2.0));
-			locDistances[origId][destId] = locDistances[destId][origId] = distance;
-			if (distance > maxLocDistance)
-				maxLocDistance = distance;
-		}
-	}
-
-	//Recalculate distances proportionally to max transition time 
-	//and initialize transition times for each equipment type
-	int origJobLocId, destJobLocId;
-	double transitionTime;
-	std::vector<Equipment *>::iterator vepIt = equipments.begin();
-	for (; vepIt != equipments.end();vepIt++){
-		/// dummy job is also used
-		std::vector<std::vector<double>> jobTransitionTimes(numJobs + 1, std::vector<double>(numJobs + 1, 0));
-		for (int origJob = 0; origJob < numJobs; origJob++){
-			/// to real jobs
-			for (int destJob = origJob + 1; destJob < numJobs; destJob++){
-				origJobLocId = jobs[origJob]->getLocationId();
-				destJobLocId = jobs[destJob]->getLocationId();
-				double dist = (double) locDistances[origJobLocId][destJobLocId];
-				if ((*vepIt)->getMaxTransitionTime() <= 0){ //dont recalculate
-					transitionTime = dist;
-				}else{
-					transitionTime = (double) (dist / maxLocDistance * (*vepIt)->getMaxTransitionTime());
-				}
-				jobTransitionTimes[destJob][origJob] = jobTransitionTimes[origJob][destJob] = transitionTime;
-			}
-		}
-		(*vepIt)->setTransitionTimes(jobTransitionTimes);
-	}
-
-	//Set time windows for all jobs
-	for(int j=0; j<numJobs; j++){		
-		jobs[j]->setTimePeriods(horizonLength, equipments);
-	}
-
-	//Initialize problem network
-	problemNetwork = vector<vector<Vertex*>>(numJobs, vector<Vertex*>(horizonLength + 1, nullptr));
-	vertexSet = set<Vertex*,VertexComparator>();
-	parameters = GlobalParameters::getInstance();
-	parameters->setNumJobs(numJobs);
-	parameters->setNumEquipments(numEquipments);
-	parameters->setHorizonLength(horizonLength);
-
-	
-}
+#include "Data.h"
+#include "Solution.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <math.h>
+#include <algorithm>
+
+void ProblemData::readData(const std::string & fileName)
+{
+	ifstream in;
+	in.open(fileName.c_str());
+	if (!in)
+	{
+		std::cout << "Instance does not exist." << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	string line, str;
+	string space;
+	int sw = 0;
+	int con = 0;
+	int precCounter = 0;
+
+	std::vector<Location*> locations;
+
+	while (getline(in, line))
+	{
+		if (line.find('#') != string::npos) //Header line
+		{ 
+			sw++;
+			continue;
+		}
+
+		stringstream is(line);
+		switch (sw)
+		{
+		case 1:
+			is >> numEquipments;
+			equipments.resize(numEquipments);
+			sw++;
+			break;
+		case 2:
+			//types of equipment
+			int equipmentId, machineQty, maxTransitionTime, capacity;
+			is >> equipmentId >> machineQty >> maxTransitionTime >> capacity;
+			equipments[equipmentId] = new Equipment(equipmentId, machineQty, maxTransitionTime,	capacity);
+			break;
+		case 3:
+			is >> numLocations;
+			locations.resize(numLocations);
+			sw++;
+			break;
+		case 4:
+			//locations
+			int locationId, x, y;
+			is >> locationId >> x >> y;
+			locations[locationId] = new Location(locationId, x, y);
+			break;
+		case 5:
+			//total workshifts
+			is >> horizonLength >> numWorkShifts;
+			workShiftLength = horizonLength / numWorkShifts;
+			if (workShiftLength * numWorkShifts != horizonLength)
+				horizonLength = workShiftLength * numWorkShifts;
+			break;
+		case 6:
+			//total Jobs
+			is >> numJobs;
+			jobs.resize(numJobs); 
+			successors.resize(numJobs);
+			predecessors.resize(numJobs);
+			sw++;
+			break;
+		case 7:
+		{
+			int jobId, weight, serviceTime, demand, numWS, locId;
+			std::vector<bool> workShifts(numWorkShifts, false);
+			std::vector<int> readyDates(numWorkShifts, 0);
+			std::vector<int> dueDates(numWorkShifts, 0);
+			std::vector<int> machineTypes(numEquipments);
+
+			is >> jobId >> weight >> serviceTime >> locId >> demand;
+			jobs[jobId] = new Job(jobId, weight, serviceTime, locId, demand);
+
+			for (int j = 0; j < numEquipments; j++)
+				is >> machineTypes[j];
+			jobs[jobId]->setEquipmentTypes(machineTypes);
+
+			is >> numWS;
+			for (int sh = 0; sh < numWS; sh++)
+			{
+				int id, rel, due;
+				is >> id >> rel >> due;
+				workShifts[id] = true;
+				readyDates[id] = rel;
+				dueDates[id] = due;
+			}
+			jobs[jobId]->setWorkShifts(workShifts);
+			jobs[jobId]->setReadyDates(readyDates);
+			jobs[jobId]->setDueDates(dueDates);
+			break;
+		}
+		case 8:
+			//total precedences
+			is >> numPrecedences;
+			sw++;
+			break;
+		case 9:
+			int before, after, delta;
+			is >> before >> after >> delta;
+			if(before < 1 || before >= numJobs || after < 1 || after >= numJobs || before == after){
+				cout << "Precedence " << before << " -> " << after << " ignored." << endl;
+				break;
+			}
+			successors[before].push_back(make_pair(after, delta));
+			predecessors[after].push_back(make_pair(before, delta));
+			precCounter++;
+			break;
+		}
+	}
+
+	/// Calculate distances between locations
+	std::vector<std::vector<double>> locDistances(numLocations,std::vector<double>(numLocations, 0.0));
+	Location *origLocPtr, *destLocPtr;
+	double maxLocDistance = 0;
+	for (int origId = 0; origId < numLocations - 1; origId++)
+	{
+		for (int destId = origId + 1; destId < numLocations; destId++)
+		{
+			origLocPtr = locations[origId];
+			destLocPtr = locations[destId];
+			double distance = sqrt(
+				pow(origLocPtr->getX() - destLocPtr->getX(), 2.0)
+				+ pow(origLocPtr->getY() - destLocPtr->getY(), 2.0));
+			locDistances[origId][destId] = locDistances[destId][origId] = distance;
+			if (distance > maxLocDistance)
+				maxLocDistance = distance;
+		}
+	}
+
+	//Recalculate distances proportionally to max transition time 
+	//and initialize transition times for each equipment type
+	int origJobLocId, destJobLocId;
+	double transitionTime;
+	std::vector<Equipment *>::iterator vepIt = equipments.begin();
+	for (; vepIt != equipments.end();vepIt++){
+		/// dummy job is also used
+		std::vector<std::vector<double>> jobTransitionTimes(numJobs + 1, std::vector<double>(numJobs + 1, 0));
+		for (int origJob = 0; origJob < numJobs; origJob++){
+			/// to real jobs
+			for (int destJob = origJob + 1; destJob < numJobs; destJob++){
+				origJobLocId = jobs[origJob]->getLocationId();
+				destJobLocId = jobs[destJob]->getLocationId();
+				double dist = (double) locDistances[origJobLocId][destJobLocId];
+				if ((*vepIt)->getMaxTransitionTime() <= 0){ //dont recalculate
+					transitionTime = dist;
+				}else{
+					transitionTime = (double) (dist / maxLocDistance * (*vepIt)->getMaxTransitionTime());
+				}
+				jobTransitionTimes[destJob][origJob] = jobTransitionTimes[origJob][destJob] = transitionTime;
+			}
+		}
+		(*vepIt)->setTransitionTimes(jobTransitionTimes);
+	}
+
+	//Set time windows for all jobs
+	int shiftLength = (GlobalParameters::getInstance()->useShiftDecomposition())? workShiftLength : horizonLength;
+	for(int j=0; j<numJobs; j++){		
+		jobs[j]->setTimePeriods(horizonLength, shiftLength, equipments);
+	}
+	if(precCounter > 0) cout << precCounter << " precedences read." << endl;
+	tightenTimeWindows();
+
+	//Initialize problem network
+	problemNetwork = VertexIndex(numJobs);
+	vertexSet = set<Vertex*,VertexComparator>();
+	parameters = GlobalParameters::getInstance();
+	parameters->setNumJobs(numJobs);
+	parameters->setNumEquipments(numEquipments);
+	parameters->setHorizonLength(horizonLength);
+
+	
+}
+
+void ProblemData::tightenTimeWindows()
+{
+	//Start times of job j are bounded, for every equipment type e it requires, by the earliest arrival from
+	//its predecessors (the depot leaves at 0) and the latest departure towards its successors (the depot
+	//is reached at the horizon). All of them start j together, so the bounds of each type are intersected.
+	//Precedences bound them as well.
+	//Tightening a window may tighten its neighbours, so the pass is repeated until nothing changes.
+	int before = 0, after = 0, iterations = 0;
+	for(int j=1; j < numJobs; j++){
+		before += jobs[j]->getNumStartTimes();
+	}
+
+	bool changed = true;
+	while(changed){
+		changed = false;
+		iterations++;
+
+		for(int j=1; j < numJobs; j++){
+			Job *job = jobs[j];
+			if(job->getStartIntervals().size() == 0) continue;
+
+			int first = job->getFirstStartTimePeriod();
+			int last = job->getLastStartTimePeriod();
+
+			for(int eqType=0; eqType < numEquipments; eqType++){
+				if(job->getEquipmentTypeRequired(eqType) <= 0) continue;
+				Equipment *e = equipments[eqType];
+
+				int earliest = jobs[0]->getServiceTime() + (int)e->getTransitionTime(0,j);
+				int latest = horizonLength - job->getServiceTime() - (int)e->getTransitionTime(j,0);
+				for(int i=1; i < numJobs; i++){
+					Job *other = jobs[i];
+					if(i == j || other->getEquipmentTypeRequired(eqType) <= 0 || other->getStartIntervals().size() == 0) continue;
+
+					earliest = min(earliest, other->getFirstStartTimePeriod() + other->getServiceTime() + (int)e->getTransitionTime(i,j));
+					latest = max(latest, other->getLastStartTimePeriod() - job->getServiceTime() - (int)e->getTransitionTime(j,i));
+				}
+
+				first = max(first, earliest);
+				last = min(last, latest);
+			}
+
+			//Precedences: j starts delta periods after the earliest start of a predecessor at least,
+			//and before the latest start of a successor
+			for(unsigned int p=0; p < predecessors[j].size(); p++){
+				Job *other = jobs[predecessors[j][p].first];
+				if(other->getStartIntervals().size() > 0) first = max(first, other->getFirstStartTimePeriod() + predecessors[j][p].second);
+			}
+			for(unsigned int p=0; p < successors[j].size(); p++){
+				Job *other = jobs[successors[j][p].first];
+				if(other->getStartIntervals().size() > 0) last = min(last, other->getLastStartTimePeriod() - successors[j][p].second);
+			}
+
+			if(job->tightenStartTimes(first, last)){
+				changed = true;
+				if(job->getStartIntervals().size() == 0)
+					cout << "Job " << j << " can not be served within its time windows." << endl;
+			}
+		}
+	}
+
+	for(int j=1; j < numJobs; j++){
+		after += jobs[j]->getNumStartTimes();
+	}
+	cout << "Time window tightening: " << before << " -> " << after << " start time periods";
+	if(before > 0) cout << " (" << 100.0 * (before - after) / before << "% removed)";
+	cout << " in " << iterations << " passes." << endl;
+}
+
+int ProblemData::getLoadCapacity(int eqType)
+{
+	int capacity = equipments[eqType]->getCapacity();
+	if(capacity <= 0) return 0;
+
+	int totalDemand = 0;
+	for(int j=1; j < numJobs; j++){
+		if(jobs[j]->getEquipmentTypeRequired(eqType) > 0) totalDemand += max(0, jobs[j]->getDemand());
+	}
+	return (totalDemand > capacity)? capacity : 0;
+}
+
+bool ProblemData::hasLoadResource()
+{
+	for(int eqType=0; eqType < numEquipments; eqType++){
+		if(getLoadCapacity(eqType) > 0) return true;
+	}
+	return false;
+}
+
+bool ProblemData::getPrecedenceLag(int i, int j, int &delta)
+{
+	//True if job j has to start at least delta periods after job i
+	if(i <= 0 || i >= (int)successors.size()) return false;
+
+	bool found = false;
+	for(unsigned int p=0; p < successors[i].size(); p++){
+		if(successors[i][p].first == j && (!found || successors[i][p].second > delta)){
+			delta = successors[i][p].second;
+			found = true;
+		}
+	}
+	return found;
+}
+
+int ProblemData::getNumNetworkShifts()
+{
+	if(!parameters->useShiftDecomposition() || numWorkShifts <= 1) return 1;
+	return numWorkShifts;
+}
+
+int ProblemData::getShiftStart(int t)
+{
+	if(getNumNetworkShifts() <= 1) return 0;
+	return min(t - t % workShiftLength, horizonLength);
+}
+
+int ProblemData::getShiftEnd(int t)
+{
+	if(getNumNetworkShifts() <= 1) return horizonLength;
+	return min(getShiftStart(t) + workShiftLength, horizonLength);
+}
+
+void ProblemData::initTimePoints()
+{
+	//Partial discretization: every job starts with the first period of each of its start intervals
+	timePoints = vector<vector<int>>(numJobs);
+	for(int j=1; j < numJobs; j++){
+		vector<pair<int,int>> &intervals = jobs[j]->getStartIntervals();
+		for(unsigned int k=0; k < intervals.size(); k++){
+			timePoints[j].push_back(intervals[k].first);
+		}
+	}
+}
+
+bool ProblemData::addTimePoint(int job, int t)
+{
+	if(timePoints.size() == 0 || job == 0 || !jobs[job]->isStartTimeFeasible(t)) return false;
+
+	vector<int>::iterator it = lower_bound(timePoints[job].begin(), timePoints[job].end(), t);
+	if(it != timePoints[job].end() && (*it) == t) return false;
+	timePoints[job].insert(it, t);
+	return true;
+}
+
+int ProblemData::getTimePoint(int job, int t)
+{
+	//Last time point of job not after t (t itself with the full discretization)
+	if(timePoints.size() == 0 || job == 0) return t;
+
+	vector<int>::iterator it = upper_bound(timePoints[job].begin(), timePoints[job].end(), t);
+	if(it == timePoints[job].begin()) return -1;
+	return *(--it);
+}
+
+int ProblemData::getNextTimePoint(int job, int t)
+{
+	//First time point of job not before t (-1 if there is none)
+	if(timePoints.size() == 0) return jobs[job]->getNextStartTime(t);
+
+	vector<int>::iterator it = lower_bound(timePoints[job].begin(), timePoints[job].end(), t);
+	return (it == timePoints[job].end())? -1 : (*it);
+}
+
+int ProblemData::getNumTimePoints()
+{
+	int count = 0;
+	for(unsigned int j=0; j < timePoints.size(); j++){
+		count += timePoints[j].size();
+	}
+	return count;
+}
+
+int ProblemData::refineTimePoints(Solution *solution)
+{
+	//The solution is feasible in the full discretization if no arc arrives after the start of its end job.
+	//Otherwise the real arrival of every too short arc becomes a time point; returns the points added
+	if(solution == nullptr || timePoints.size() == 0) return 0;
+
+	const vector<int> &edges = solution->getEdges();
+	vector<int> startTime = vector<int>(numJobs, -1);
+	for(unsigned int k=0; k + 4 < edges.size(); k += 5){
+		if(edges[k] != 0) startTime[edges[k]] = edges[k+2];
+	}
+
+	int added = 0;
+	for(unsigned int k=0; k + 4 < edges.size(); k += 5){
+		int sJob = edges[k], dJob = edges[k+1], sTime = edges[k+2], eqType = edges[k+4];
+		if(dJob == 0 || sJob == dJob) continue;
+
+		int arriveTime = jobs[dJob]->getNextStartTime(sTime + jobs[sJob]->getServiceTime() + (int)equipments[eqType]->getTransitionTime(sJob,dJob));
+		if(arriveTime > startTime[dJob] && addTimePoint(dJob, arriveTime)) added++;
+	}
+
+	return added;
+}
+
+void ProblemData::clearNetwork()
+{
+	problemNetwork.clear();
+	vertexSet.clear();
+	vertexPool.clear();
+	numArcs = 0;
+}
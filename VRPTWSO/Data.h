@@ -1,51 +1,79 @@
-#pragma once
-
-#include "Job.h"
-#include "Equipment.h"
-#include "Location.h"
-#include "Bucket.h"
-#include "GlobalParameters.h"
-
-#include <string>
-#include <vector>
-#include <set>
-
-#ifdef DEBUG
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
-#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
-#define new DEBUG_NEW
-#endif
-
-using namespace std;
-
-struct ProblemData
-{
-	ProblemData(): numJobs(0), numEquipments(0), numLocations(0), numPrecedences(0), horizonLength(0), numWorkShifts(0), workShiftLength(0) {}
-
-	int numJobs;
-	int numEquipments;
-	int numLocations;
-	int numPrecedences;
-	int horizonLength;
-	int numWorkShifts;
-	int workShiftLength;
-
-	vector<Job*> jobs;
-	vector<Equipment*> equipments;
-
-	GlobalParameters *parameters;
-	int getNumJobs() const{ return numJobs; }
-	int getHorizonLength() const { return horizonLength; }
-
-	//successors of job i on machine e
-	vector<vector<vector<int>>> successors;
-
-	//problem network
-	vector<vector<Vertex*>> problemNetwork;
-	set<Vertex*,VertexComparator> vertexSet;
-
-	void readData(const std::string & inputFileName);
-};
-
+#pragma once
+
+#include "Job.h"
+#include "Equipment.h"
+#include "Location.h"
+#include "Bucket.h"
+#include "GlobalParameters.h"
+
+#include <string>
+#include <vector>
+#include <set>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+class Solution;
+
+struct ProblemData
+{
+	ProblemData(): numJobs(0), numEquipments(0), numLocations(0), numPrecedences(0), horizonLength(0), numWorkShifts(0), workShiftLength(0), numArcs(0) {}
+
+	int numJobs;
+	int numEquipments;
+	int numLocations;
+	int numPrecedences;
+	int horizonLength;
+	int numWorkShifts;
+	int workShiftLength;
+
+	vector<Job*> jobs;
+	vector<Equipment*> equipments;
+
+	GlobalParameters *parameters;
+	int getNumJobs() const{ return numJobs; }
+	int getHorizonLength() const { return horizonLength; }
+
+	//Precedences: (j,delta) for every job j that starts at least delta periods after job i starts
+	vector<vector<pair<int,int>>> successors;
+	//(i,delta) for every job i that job j has to follow
+	vector<vector<pair<int,int>>> predecessors;
+	bool getPrecedenceLag(int i, int j, int &delta);
+
+	//problem network
+	VertexIndex problemNetwork;
+	set<Vertex*,VertexComparator> vertexSet;
+	vector<Vertex> vertexPool; //storage of the vertices, in topological order
+	int numArcs;
+
+	void readData(const std::string & inputFileName);
+	void tightenTimeWindows();
+
+	//Load resource: capacity of eqType if the demands of its jobs can exceed it (0 = no load resource)
+	int getLoadCapacity(int eqType);
+	bool hasLoadResource();
+
+	//Work shift decomposition: the network has a depot vertex at the start of every shift, routes go back to
+	//the depot at the end of each shift (without the decomposition there is one shift, the whole horizon)
+	int getNumNetworkShifts();
+	int getShiftStart(int t);
+	int getShiftEnd(int t);
+
+	//Dynamic discretization: time points of each job kept in the network (none = every start time period)
+	vector<vector<int>> timePoints;
+	void initTimePoints();
+	bool addTimePoint(int job, int t);
+	int getTimePoint(int job, int t);
+	int getNextTimePoint(int job, int t);
+	int getNumTimePoints();
+	int refineTimePoints(Solution *solution);
+	void clearNetwork();
+};
+
@@ -1,20 +1,56 @@
-#include "GlobalParameters.h"
-#include <stdio.h>
-
-GlobalParameters* GlobalParameters::instance = NULL;
-
-GlobalParameters::GlobalParameters()
-{
-	bigM = 10000;
-	epsilon = 1e-5;
-	maxRoutesPerIteration = 5;
-	dualStabilization = false;
-}
-
-GlobalParameters* GlobalParameters::getInstance()
-{
-	if(!instance){
-		instance = new GlobalParameters();
-	}
-	return instance;
+#include "GlobalParameters.h"
+#include <stdio.h>
+#include <omp.h>
+
+GlobalParameters* GlobalParameters::instance = NULL;
+
+GlobalParameters::GlobalParameters()
+{
+	bigM = 10000;
+	epsilon = 1e-5;
+	maxRoutesPerIteration = 5;
+	dualStabilization = false;
+	ovfHeuristic = false;
+	localSearchMaxPasses = 50;
+	rmpHeuristicFrequency = 5;
+	rmpHeuristicTimeLimit = 10.0;
+	divingFrequency = 20;
+	divingMaxBacktracks = 2;
+	enumerationGap = 1.0;
+	maxEnumeratedRoutes = 50000;
+	enumerationTimeLimit = 300.0;
+	strongBranchingCandidates = 5;
+	strongBranchingIterations = 10;
+	reliabilityThreshold = 4;
+	branchingHierarchy = "mfta";
+	nodeSelection = 1; //best first
+	plungingFrequency = 10;
+	maxPlungeDepth = 5;
+	maxOpenNodes = 10000;
+	maxOpenNodesMemory = 4096;
+	nodeStoreMemory = 1024;
+	numThreads = omp_get_num_procs();
+	treeWorkers = 1;
+	columnPoolSize = 5000;
+	rootCutRounds = 20;
+	treeCutRounds = 1;
+	maxCutsPerRound = 50;
+	cutMaxAge = 5;
+	maxSubsetRowCuts = 30;
+	dynamicDiscretization = false;
+	contractedNetwork = false;
+	shiftDecomposition = false;
+	rollingWindowLength = 0;
+	rollingCommitLength = 0;
+	checkpointFile = "";
+	checkpointInterval = 600;
+	resume = false;
+}
+
+GlobalParameters* GlobalParameters::getInstance()
+{
+	if(!instance){
+		instance = new GlobalParameters();
+	}
+	return instance;
 }
\ No newline at end of file
@@ -1,40 +1,177 @@
-#pragma once
-
-class GlobalParameters
-{
-public:
-	static GlobalParameters *getInstance();
-
-	//GET METHODS
-	double getBigM(){ return bigM; }
-	double getEpsilon(){ return epsilon; }
-	int getMaxRoutes(){ return maxRoutesPerIteration; }
-	bool useDualStabilization(){ return dualStabilization; }
-
-	int getNumJobs(){ return numJobs; }
-	int getNumEquipments(){ return numEquipments; }
-	int getHorizonLength(){ return horizon; }
-
-	//SET METHODS
-	void setBigM(double m){ bigM = m; }
-	void setEpsilon(double e){ epsilon = e; }
-	void setMaxRoutes(int max){ maxRoutesPerIteration = max; }
-	void setDualStabilization(bool opt){ dualStabilization = opt; }
-
-	void setNumJobs(int n){ numJobs = n; }
-	void setNumEquipments(int e){ numEquipments = e; }
-	void setHorizonLength(int h){ horizon = h; }
-
-private:
-	GlobalParameters();
-	static GlobalParameters *instance;
-
-	int numJobs;
-	int numEquipments;
-	int horizon;
-
-	double bigM;
-	double epsilon;
-	int maxRoutesPerIteration;
-	bool dualStabilization;
+#pragma once
+
+#include <string>
+
+class GlobalParameters
+{
+public:
+	static GlobalParameters *getInstance();
+
+	//GET METHODS
+	double getBigM(){ return bigM; }
+	double getEpsilon(){ return epsilon; }
+	int getMaxRoutes(){ return maxRoutesPerIteration; }
+	bool useDualStabilization(){ return dualStabilization; }
+	bool useOVFHeuristic(){ return ovfHeuristic; }
+	int getLocalSearchMaxPasses(){ return localSearchMaxPasses; }
+	int getRMPHeuristicFrequency(){ return rmpHeuristicFrequency; }
+	double getRMPHeuristicTimeLimit(){ return rmpHeuristicTimeLimit; }
+	int getDivingFrequency(){ return divingFrequency; }
+	int getDivingMaxBacktracks(){ return divingMaxBacktracks; }
+	double getEnumerationGap(){ return enumerationGap; }
+	int getMaxEnumeratedRoutes(){ return maxEnumeratedRoutes; }
+	double getEnumerationTimeLimit(){ return enumerationTimeLimit; }
+	int getStrongBranchingCandidates(){ return strongBranchingCandidates; }
+	int getStrongBranchingIterations(){ return strongBranchingIterations; }
+	int getReliabilityThreshold(){ return reliabilityThreshold; }
+	std::string getBranchingHierarchy(){ return branchingHierarchy; }
+	int getNodeSelection(){ return nodeSelection; }
+	int getPlungingFrequency(){ return plungingFrequency; }
+	int getMaxPlungeDepth(){ return maxPlungeDepth; }
+	int getMaxOpenNodes(){ return maxOpenNodes; }
+	double getMaxOpenNodesMemory(){ return maxOpenNodesMemory; }
+	double getNodeStoreMemory(){ return nodeStoreMemory; }
+	int getNumThreads(){ return numThreads; }
+	int getTreeWorkers(){ return treeWorkers; }
+	std::string getCheckpointFile(){ return checkpointFile; }
+	int getCheckpointInterval(){ return checkpointInterval; }
+	bool resumeFromCheckpoint(){ return resume; }
+	int getColumnPoolSize(){ return columnPoolSize; }
+	int getRootCutRounds(){ return rootCutRounds; }
+	int getTreeCutRounds(){ return treeCutRounds; }
+	int getMaxCutsPerRound(){ return maxCutsPerRound; }
+	int getCutMaxAge(){ return cutMaxAge; }
+	int getMaxSubsetRowCuts(){ return maxSubsetRowCuts; }
+	bool useDynamicDiscretization(){ return dynamicDiscretization; }
+	bool useContractedNetwork(){ return contractedNetwork; }
+	bool useShiftDecomposition(){ return shiftDecomposition; }
+	int getRollingWindowLength(){ return rollingWindowLength; }
+	int getRollingCommitLength(){ return rollingCommitLength; }
+
+	int getNumJobs(){ return numJobs; }
+	int getNumEquipments(){ return numEquipments; }
+	int getHorizonLength(){ return horizon; }
+
+	//SET METHODS
+	void setBigM(double m){ bigM = m; }
+	void setEpsilon(double e){ epsilon = e; }
+	void setMaxRoutes(int max){ maxRoutesPerIteration = max; }
+	void setDualStabilization(bool opt){ dualStabilization = opt; }
+	void setOVFHeuristic(bool opt){ ovfHeuristic = opt; }
+	void setLocalSearchMaxPasses(int max){ localSearchMaxPasses = max; }
+	void setRMPHeuristicFrequency(int freq){ rmpHeuristicFrequency = freq; }
+	void setRMPHeuristicTimeLimit(double time){ rmpHeuristicTimeLimit = time; }
+	void setDivingFrequency(int freq){ divingFrequency = freq; }
+	void setDivingMaxBacktracks(int max){ divingMaxBacktracks = max; }
+	void setEnumerationGap(double gap){ enumerationGap = gap; }
+	void setMaxEnumeratedRoutes(int max){ maxEnumeratedRoutes = max; }
+	void setEnumerationTimeLimit(double time){ enumerationTimeLimit = time; }
+	void setStrongBranchingCandidates(int n){ strongBranchingCandidates = n; }
+	void setStrongBranchingIterations(int max){ strongBranchingIterations = max; }
+	void setReliabilityThreshold(int n){ reliabilityThreshold = n; }
+	void setBranchingHierarchy(std::string h){ branchingHierarchy = h; }
+	void setNodeSelection(int s){ nodeSelection = s; }
+	void setPlungingFrequency(int freq){ plungingFrequency = freq; }
+	void setMaxPlungeDepth(int max){ maxPlungeDepth = max; }
+	void setMaxOpenNodes(int max){ maxOpenNodes = max; }
+	void setMaxOpenNodesMemory(double mb){ maxOpenNodesMemory = mb; }
+	void setNodeStoreMemory(double mb){ nodeStoreMemory = mb; }
+	void setNumThreads(int n){ numThreads = n; }
+	void setTreeWorkers(int n){ treeWorkers = n; }
+	void setCheckpointFile(std::string file){ checkpointFile = file; }
+	void setCheckpointInterval(int seconds){ checkpointInterval = seconds; }
+	void setResume(bool r){ resume = r; }
+	void setColumnPoolSize(int size){ columnPoolSize = size; }
+	void setRootCutRounds(int rounds){ rootCutRounds = rounds; }
+	void setTreeCutRounds(int rounds){ treeCutRounds = rounds; }
+	void setMaxCutsPerRound(int max){ maxCutsPerRound = max; }
+	void setCutMaxAge(int age){ cutMaxAge = age; }
+	void setMaxSubsetRowCuts(int max){ maxSubsetRowCuts = (max > 64)? 64 : max; }
+	void setDynamicDiscretization(bool opt){ dynamicDiscretization = opt; }
+	void setContractedNetwork(bool opt){ contractedNetwork = opt; }
+	void setShiftDecomposition(bool opt){ shiftDecomposition = opt; }
+	void setRollingWindowLength(int length){ rollingWindowLength = length; }
+	void setRollingCommitLength(int length){ rollingCommitLength = length; }
+
+	void setNumJobs(int n){ numJobs = n; }
+	void setNumEquipments(int e){ numEquipments = e; }
+	void setHorizonLength(int h){ horizon = h; }
+
+private:
+	GlobalParameters();
+	static GlobalParameters *instance;
+
+	int numJobs;
+	int numEquipments;
+	int horizon;
+
+	double bigM;
+	double epsilon;
+	int maxRoutesPerIteration;
+	bool dualStabilization;
+
+	//Initial solution
+	bool ovfHeuristic;
+	int localSearchMaxPasses;
+
+	//Restricted master heuristic (run on nodes whose depth is a multiple of the frequency, 0 = never)
+	int rmpHeuristicFrequency;
+	double rmpHeuristicTimeLimit;
+
+	//Price and dive (run at the root and every divingFrequency explored nodes, 0 = never)
+	int divingFrequency;
+	int divingMaxBacktracks;
+
+	//Route enumeration at the root when its gap (%) is below enumerationGap (0 = never)
+	double enumerationGap;
+	int maxEnumeratedRoutes;
+	double enumerationTimeLimit;
+
+	//Reliability branching: unreliable candidates are evaluated by truncated column generation
+	int strongBranchingCandidates;
+	int strongBranchingIterations;
+	int reliabilityThreshold;
+
+	//Branching levels in order: m = machines, f = job pair flow, t = time window, a = arc
+	std::string branchingHierarchy;
+
+	//Node selection (see NodeSelection), plunging and limits (nodes and MB) to switch to depth first
+	int nodeSelection;
+	int plungingFrequency;
+	int maxPlungeDepth;
+	int maxOpenNodes;
+	double maxOpenNodesMemory;
+	//Memory (MB) of the open nodes kept in memory, the rest are stored on disk (0 = never)
+	double nodeStoreMemory;
+
+	//Parallelism
+	int numThreads;
+	//Workers of the parallel tree search (they share numThreads) and size of their shared column pool
+	int treeWorkers;
+	int columnPoolSize;
+
+	//Robust cuts: separation rounds at the root and at the other nodes (0 = never), cuts per round and
+	//rounds a cut stays in a node without being binding
+	int rootCutRounds;
+	int treeCutRounds;
+	int maxCutsPerRound;
+	int cutMaxAge;
+	//Subset row cuts active in a node per equipment type (0 = none, at most 64: one bit of the label state each)
+	int maxSubsetRowCuts;
+
+	//Solve on a partial time discretization, refined until the solution is feasible in the full one
+	bool dynamicDiscretization;
+	//Pricing over the event vertices only (chains of vertices only entered by waiting arcs are merged)
+	bool contractedNetwork;
+	//Machines return to the depot at the end of every work shift, so each shift is priced on its own (in parallel)
+	bool shiftDecomposition;
+	//Rolling horizon: windows of rollingWindowLength periods solved one after another, the first rollingCommitLength
+	//periods of each one are frozen (0 = the whole horizon is solved at once)
+	int rollingWindowLength;
+	int rollingCommitLength;
+
+	//Checkpoint of the tree search written every checkpointInterval seconds (no file = never)
+	std::string checkpointFile;
+	int checkpointInterval;
+	bool resume;
 };
\ No newline at end of file
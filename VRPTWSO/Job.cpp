@@ -1,47 +1,114 @@
-#include "Job.h"
-#include <math.h>
-
-void Job::setTimePeriods(int horizonLength, const vector<Equipment*>& equipments)
-{
-	timePeriods = std::vector<bool>(horizonLength + 1, false);
-	timePeriodsSet.clear();
-	int timeIndex, shiftIndex;	
-
-	//Let the time window of sJob be denoted by [a;b], transition time of sJob to depot by dTime and the horizon length by T
-	//The time window of sJob can safely be shrinked to [max(a,dTime);min(b,T-dTime-serviceTime)]
-	int timeToDepot = 10000000;
-	for(int eqType = 0; eqType < equipmentTypes.size(); eqType++){
-		if(equipmentTypes[eqType])
-			timeToDepot = min(timeToDepot, (int)equipments[eqType]->getTransitionTime(id,0));
-	}
-	
-	for (shiftIndex = 0; shiftIndex < workShifts.size(); shiftIndex++)
-	{
-		if (!workShifts[shiftIndex]) continue;
-
-		for (timeIndex = readyDates[shiftIndex]; timeIndex <= dueDates[shiftIndex] /*- serviceTime*/; timeIndex++){
-			//shrink time window
-			if(timeIndex > (horizonLength - serviceTime - timeToDepot)) break;
-			if(timeIndex < timeToDepot) continue;
-			//------------------
-
-			timePeriods[timeIndex] = true;
-			timePeriodsSet.insert(timeIndex);
-			firstStartTimePeriod = min(firstStartTimePeriod,timeIndex);
-			lastStartTimePeriod = timeIndex;
-		}
-	}
-}
-
-int Job::getFirstEquipmentType()
-{
-	int eq;
-
-	for(eq=0; eq<equipmentTypes.size(); eq++)
-	{
-		if(equipmentTypes[eq] != 0) 
-			break;
-	}
-
-	return eq;
+#include "Job.h"
+#include <math.h>
+#include <algorithm>
+
+void Job::setTimePeriods(int horizonLength, int shiftLength, const vector<Equipment*>& equipments)
+{
+	startIntervals.clear();
+	firstStartTimePeriod = 100000;
+	lastStartTimePeriod = 0;
+	int shiftIndex;
+
+	//Let the time window of sJob be denoted by [a;b], transition time of sJob to depot by dTime and the horizon length by T
+	//The time window of sJob can safely be shrinked to [max(a,dTime);min(b,T-dTime-serviceTime)]
+	//With the work shift decomposition (shiftLength < T) the same is done within the bounds of each shift
+	int timeToDepot = 10000000;
+	for(int eqType = 0; eqType < equipmentTypes.size(); eqType++){
+		if(equipmentTypes[eqType])
+			timeToDepot = min(timeToDepot, (int)equipments[eqType]->getTransitionTime(id,0));
+	}
+	
+	for (shiftIndex = 0; shiftIndex < workShifts.size(); shiftIndex++)
+	{
+		if (!workShifts[shiftIndex]) continue;
+
+		int shiftStart = (shiftLength < horizonLength)? shiftIndex * shiftLength : 0;
+		int shiftEnd = (shiftLength < horizonLength)? min(horizonLength, (shiftIndex + 1) * shiftLength) : horizonLength;
+
+		//shrink time window
+		int first = max(readyDates[shiftIndex], shiftStart + timeToDepot);
+		int last = min(dueDates[shiftIndex] /*- serviceTime*/, shiftEnd - serviceTime - timeToDepot);
+		if(first > last) continue;
+		//------------------
+
+		startIntervals.push_back(make_pair(first, last));
+	}
+
+	//Overlapping or adjacent shifts are merged
+	sort(startIntervals.begin(), startIntervals.end());
+	vector<pair<int,int>> merged;
+	for(unsigned int k=0; k < startIntervals.size(); k++){
+		if(merged.size() > 0 && startIntervals[k].first <= merged.back().second + 1)
+			merged.back().second = max(merged.back().second, startIntervals[k].second);
+		else
+			merged.push_back(startIntervals[k]);
+	}
+	startIntervals = merged;
+
+	if(startIntervals.size() > 0){
+		firstStartTimePeriod = startIntervals.front().first;
+		lastStartTimePeriod = startIntervals.back().second;
+	}
+}
+
+bool Job::tightenStartTimes(int first, int last)
+{
+	//Keep only the start times in [first,last], returns true if any is removed
+	vector<pair<int,int>> kept;
+	for(unsigned int k=0; k < startIntervals.size(); k++){
+		int a = max(startIntervals[k].first, first);
+		int b = min(startIntervals[k].second, last);
+		if(a <= b) kept.push_back(make_pair(a, b));
+	}
+
+	bool changed = (kept != startIntervals);
+	startIntervals = kept;
+	if(startIntervals.size() > 0){
+		firstStartTimePeriod = startIntervals.front().first;
+		lastStartTimePeriod = startIntervals.back().second;
+	}else{
+		firstStartTimePeriod = 100000;
+		lastStartTimePeriod = 0;
+	}
+	return changed;
+}
+
+int Job::getNumStartTimes()
+{
+	int count = 0;
+	for(unsigned int k=0; k < startIntervals.size(); k++){
+		count += startIntervals[k].second - startIntervals[k].first + 1;
+	}
+	return count;
+}
+
+bool Job::isStartTimeFeasible(int t)
+{
+	for(unsigned int k=0; k < startIntervals.size(); k++){
+		if(t < startIntervals[k].first) return false;
+		if(t <= startIntervals[k].second) return true;
+	}
+	return false;
+}
+
+int Job::getNextStartTime(int t)
+{
+	//First start time period >= t (-1 if there is none)
+	for(unsigned int k=0; k < startIntervals.size(); k++){
+		if(t <= startIntervals[k].second) return max(t, startIntervals[k].first);
+	}
+	return -1;
+}
+
+int Job::getFirstEquipmentType()
+{
+	int eq;
+
+	for(eq=0; eq<equipmentTypes.size(); eq++)
+	{
+		if(equipmentTypes[eq] != 0) 
+			break;
+	}
+
+	return eq;
 }
\ No newline at end of file
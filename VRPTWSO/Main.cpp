@@ -1,47 +1,147 @@
-#include "gurobi_c++.h"
-#include "Data.h"
-#include "Solver.h"
-#include "gurobi_c++.h"
-
-#ifdef DEBUG
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
-#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
-#define new DEBUG_NEW
-#endif
-
-using namespace std;
-
-int main(int argc, char *argv[])
-{
-	string fileName;
-	//_CrtSetBreakAlloc(173594);
-
-	//Validate parameters
-	if(argc < 1){
-		cout << "Please provide a instance file name. " << endl;
-		goto error;
-	}
-	
-	fileName = string(argv[1]);
-
-	//Create object for data reading
-	ProblemData *data = new ProblemData();
-	data->readData(fileName);
-
-	//Create solver
-	Solver *mySolver = new Solver(data);
-	int result = mySolver->solve();
-	cout << "Status final: " << result << endl;
-	
-	delete mySolver;
-
-	//_CrtDumpMemoryLeaks();
-
-	getchar();
-	return EXIT_SUCCESS;
-
-error:
-	return EXIT_FAILURE;
+#include "gurobi_c++.h"
+#include "Data.h"
+#include "Solver.h"
+#include "RollingHorizon.h"
+#include "GlobalParameters.h"
+#include "gurobi_c++.h"
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+	string fileName;
+	GlobalParameters *parameters = GlobalParameters::getInstance();
+	//_CrtSetBreakAlloc(173594);
+
+	//Validate parameters
+	if(argc < 2){
+		cout << "Please provide a instance file name. " << endl;
+		return EXIT_FAILURE;
+	}
+	
+	fileName = string(argv[1]);
+
+	//Options
+	for(int i=2; i < argc; i++){
+		string option = string(argv[i]);
+		if(option == "-ovf"){
+			parameters->setOVFHeuristic(true);
+		}else if(option == "-rmp" && i+2 < argc){
+			parameters->setRMPHeuristicFrequency(atoi(argv[++i]));
+			parameters->setRMPHeuristicTimeLimit(atof(argv[++i]));
+		}else if(option == "-dive" && i+2 < argc){
+			parameters->setDivingFrequency(atoi(argv[++i]));
+			parameters->setDivingMaxBacktracks(atoi(argv[++i]));
+		}else if(option == "-enum" && i+3 < argc){
+			parameters->setEnumerationGap(atof(argv[++i]));
+			parameters->setMaxEnumeratedRoutes(atoi(argv[++i]));
+			parameters->setEnumerationTimeLimit(atof(argv[++i]));
+		}else if(option == "-cuts" && i+3 < argc){
+			parameters->setRootCutRounds(atoi(argv[++i]));
+			parameters->setTreeCutRounds(atoi(argv[++i]));
+			parameters->setCutMaxAge(atoi(argv[++i]));
+		}else if(option == "-ddd"){
+			parameters->setDynamicDiscretization(true);
+		}else if(option == "-contract"){
+			parameters->setContractedNetwork(true);
+		}else if(option == "-shifts"){
+			parameters->setShiftDecomposition(true);
+		}else if(option == "-rolling" && i+2 < argc){
+			parameters->setRollingWindowLength(atoi(argv[++i]));
+			parameters->setRollingCommitLength(atoi(argv[++i]));
+		}else if(option == "-src" && i+1 < argc){
+			parameters->setMaxSubsetRowCuts(atoi(argv[++i]));
+		}else if(option == "-sb" && i+2 < argc){
+			parameters->setStrongBranchingCandidates(atoi(argv[++i]));
+			parameters->setStrongBranchingIterations(atoi(argv[++i]));
+		}else if(option == "-rel" && i+1 < argc){
+			parameters->setReliabilityThreshold(atoi(argv[++i]));
+		}else if(option == "-branch" && i+1 < argc){
+			parameters->setBranchingHierarchy(string(argv[++i]));
+		}else if(option == "-select" && i+1 < argc){
+			string s = string(argv[++i]);
+			parameters->setNodeSelection((s == "dfs")? 0 : (s == "be")? 2 : 1);
+		}else if(option == "-plunge" && i+2 < argc){
+			parameters->setPlungingFrequency(atoi(argv[++i]));
+			parameters->setMaxPlungeDepth(atoi(argv[++i]));
+		}else if(option == "-openlimit" && i+2 < argc){
+			parameters->setMaxOpenNodes(atoi(argv[++i]));
+			parameters->setMaxOpenNodesMemory(atof(argv[++i]));
+		}else if(option == "-store" && i+1 < argc){
+			parameters->setNodeStoreMemory(atof(argv[++i]));
+		}else if(option == "-checkpoint" && i+2 < argc){
+			parameters->setCheckpointFile(string(argv[++i]));
+			parameters->setCheckpointInterval(atoi(argv[++i]));
+		}else if(option == "--resume" && i+1 < argc){
+			parameters->setCheckpointFile(string(argv[++i]));
+			parameters->setResume(true);
+		}else if(option == "-threads" && i+1 < argc){
+			parameters->setNumThreads(atoi(argv[++i]));
+		}else if(option == "-workers" && i+1 < argc){
+			parameters->setTreeWorkers(atoi(argv[++i]));
+		}else if(option == "-pool" && i+1 < argc){
+			parameters->setColumnPoolSize(atoi(argv[++i]));
+		}else{
+			cout << "Unknown option: " << option << endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Create object for data reading
+	ProblemData *data = new ProblemData();
+	data->readData(fileName);
+
+	//Rolling horizon: overlapping windows of the horizon solved one after another
+	if(parameters->getRollingCommitLength() > 0){
+		RollingHorizon *rollingHorizon = new RollingHorizon(data);
+		cout << "Status final: " << rollingHorizon->solve() << endl;
+		delete rollingHorizon;
+
+		getchar();
+		return EXIT_SUCCESS;
+	}
+
+	//Dynamic discretization: the network only has some time points of each job, so arcs may be too short.
+	//The problem is solved again, with the arrival times of the too short arcs used by its solution, until
+	//the solution is feasible for the full discretization
+	clock_t start = clock();
+	if(parameters->useDynamicDiscretization()) data->initTimePoints();
+
+	int result;
+	for(int iteration=1; ; iteration++){
+		//Create solver
+		Solver *mySolver = new Solver(data);
+		result = mySolver->solve();
+		int added = data->refineTimePoints(mySolver->getBestSolution());
+		delete mySolver;
+
+		if(added == 0){
+			if(parameters->useDynamicDiscretization()){
+				int vertices = data->vertexSet.size(), fullVertices = 2;
+				for(int j=1; j < data->numJobs; j++){
+					fullVertices += data->jobs[j]->getNumStartTimes();
+				}
+				cout << "Dynamic discretization: " << iteration << " iterations, " << vertices << " vertices (full network: " << fullVertices;
+				cout << ") - Total time: " << (double)(clock() - start)/CLOCKS_PER_SEC << "s" << endl;
+			}
+			break;
+		}
+
+		cout << "Dynamic discretization iteration " << iteration << ": " << added << " time points added." << endl;
+		data->clearNetwork();
+	}
+	cout << "Status final: " << result << endl;
+
+	//_CrtDumpMemoryLeaks();
+
+	getchar();
+	return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -1,455 +1,1066 @@
-#include "Node.h"
-#include "Bucket.h"
-#include "Route.h"
-#include "Solution.h"
-
-#include <map>
-#include <hash_map>
-#include <cmath>
-#include <algorithm>
-#include <vector>
-
-Node::Node(int c, int e) : Zlp(1e13), nodeId(-1), routeCount(0)
-{
-	parameters = GlobalParameters::getInstance();
-	solution = nullptr;
-	cDual = c;
-	eDual = e;
-	initializePi();
-}
-
-Node::Node(const Node &other) : vHash(other.vHash), cHash(other.cHash), Zlp(1e13), 
-	nodeId(-1), solStatus(GRB_LOADED), routeCount(0)
-{
-	model = new GRBModel(*other.model);
-	parameters = GlobalParameters::getInstance();
-	solution = nullptr;
-	cDual = other.cDual;
-	eDual = other.eDual;
-	initializePi();
-}
-
-Node::~Node()
-{
-	vHash.clear();
-	cHash.clear();
-	delete model;
-}
-
-int Node::solve()
-{
-	//model->write("modelo.lp");
-	model->optimize();
-	solStatus = model->get(GRB_IntAttr_Status);
-	
-	if(solStatus != GRB_OPTIMAL && solStatus != GRB_TIME_LIMIT && solStatus != GRB_SOLUTION_LIMIT)
-		return solStatus;
-
-	Zlp = model->get(GRB_DoubleAttr_ObjVal);
-	updateVariables(solStatus);
-	if(parameters->useDualStabilization()){
-		getCurrentPi();
-		calculateAlphaPi();
-	}
-	return solStatus;
-}
-
-void Node::initializePi()
-{
-	alpha = 0.05;
-
-	alphaPi_c = valarray<double>(cDual);
-	feasiblePi_c = valarray<double>(cDual);
-	currentPi_c = valarray<double>(eDual);
-
-	alphaPi_e = valarray<double>(eDual);
-	currentPi_e = valarray<double>(eDual);
-	feasiblePi_e = valarray<double>(eDual);
-}
-
-void Node::getCurrentPi()
-{
-	double pi;
-
-	GRBConstr myConstr;
-
-	Constraint c;
-	ConstraintHash::iterator cit = cHash.begin();
-
-	while(cit != cHash.end()){
-		c = cit->first;
-		if(c.getType() == C_CARD){
-			myConstr = model->getConstrByName(c.toString());			
-			pi = myConstr.get(GRB_DoubleAttr_Pi); 
-			currentPi_c[c.getId()] = pi;
-		}else if(c.getType() == C_EXPLICIT){			
-			myConstr = model->getConstrByName(c.toString());			
-			pi = myConstr.get(GRB_DoubleAttr_Pi); 
-			currentPi_e[c.getId()] = pi;
-		}
-		cit++;
-	}
-}
-
-void Node::calculateAlphaPi()
-{
-	double alphaComp = 1 - alpha;
-
-	alphaPi_c = (alphaComp * feasiblePi_c) + (alpha * currentPi_c);
-	alphaPi_e = (alphaComp * feasiblePi_e) + (alpha * currentPi_e);
-}
-
-void Node::updatePi()
-{
-	feasiblePi_c = alphaPi_c;
-	feasiblePi_e = alphaPi_e;
-}
-
-double Node::getMaxPiDifference()
-{
-	double maxDiff;
-	valarray<double> diff1 = abs(feasiblePi_e - currentPi_e);
-	valarray<double> diff2 = abs(feasiblePi_c - currentPi_c);
-
-	maxDiff = max(diff1.max(),diff2.max());
-
-	return maxDiff;
-}
-
-void Node::updateVariables(int status)
-{
-	isInteger = true;
-
-	double val, rc;
-
-	GRBVar var;
-	VariableHash::iterator vit = vHash.begin();
-	VariableHash::iterator evit = vHash.end();
-
-	while(vit != evit){
-		var = model->getVarByName(vit->first.toString());
-
-		if(status == GRB_OPTIMAL && var.get(GRB_DoubleAttr_X) != 0){
-			vit->first.increaseRank();
-		}		
-
-		if(!model->get(GRB_IntAttr_IsMIP)){
-			rc = var.get(GRB_DoubleAttr_RC);			
-			vit->first.setReducedCost(rc);
-		}
-
-		val = var.get(GRB_DoubleAttr_X);
-		vit->first.setValue(val);
-		vit->first.setFractionality(fabs(val - 0.5));
-
-		if(val - floor(val) > parameters->getEpsilon()){
-			isInteger = false;
-		}
-
-		vit++;
-	}
-}
-
-const Variable Node::getMostFractional()
-{	
-	vector<Variable> yFractionalVars = vector<Variable>();
-	vector<Variable> xFractionalVars = vector<Variable>();
-	
-	Variable v;
-	VariableHash::iterator vit;
-
-	//Try to get any fractional variables
-	for(vit = vHash.begin(); vit != vHash.end(); vit++){
-		v = vit->first;
-		if(v.getType() == V_Y){
-			//Verify has a fractional value
-			if(v.getFractionality() != 0.5)
-				yFractionalVars.push_back(v);
-		}else if(v.getType() == V_X){
-			if(v.getFractionality() != 0.5)
-				xFractionalVars.push_back(v);
-		}
-	}
-
-	VariableFractionalityComparator comp;
-
-	//See if there are any fractional Y vars
-	if(yFractionalVars.size() > 0){
-		std::sort(yFractionalVars.begin(),yFractionalVars.end(),comp);
-		return yFractionalVars[0];
-	}else if(xFractionalVars.size() > 0){
-		std::sort(xFractionalVars.begin(),xFractionalVars.end(),comp);
-		return xFractionalVars[0];
-	}
-
-	cout << "ATENTION: No fractional variable found!!! Still not integer solution????" << endl;
-	return v;
-}
-
-bool Node::addBranchConstraint(Variable v, double rhs)
-{
-	if(vHash.find(v) != vHash.end()){
-		GRBVar var = model->getVarByName(v.toString());
-		GRBLinExpr expr = 0;
-		expr += var;
-
-		model->addConstr(expr == rhs, "Branch_" + v.toString());
-		model->update();
-		return true;
-	}
-
-	return false;
-}
-
-bool Node::addColumn(Route *route)
-{	
-	Variable v;
-
-	Constraint c1, c2;
-	ConstraintHash::iterator cit1, cit2;
-
-	int routeNumber = route->getRouteNumber();
-	int eqType = route->getEquipmentType();
-
-	//Create lambda variable
-	v.reset();
-	v.setType(V_LAMBDA);
-	v.setRouteNumber(routeNumber);
-	v.setEquipmentTipe(eqType);
-
-	if(vHash.find(v) != vHash.end()){
-		std::cout << "Adding Column " << v.toString() << ": Lambda variable already existed! " << std::endl;
-		return false;
-	}
-
-	vHash[v] = true;
-	GRBVar lambda = model->addVar(0.0,GRB_INFINITY,0.0,GRB_CONTINUOUS,v.toString());
-	model->update(); 
-
-	//Add column (Card constraints)
-	c1.reset();
-	c1.setType(C_CARD);
-	c1.setEquipmentType(eqType);
-
-	if(cHash.find(c1) == cHash.end()){
-		std::cout << "Adding Column " << v.toString() << ": Cardinality constraint didn't exist." << std::endl;
-		return false;
-	}
-	GRBConstr cardConstr = model->getConstrByName(c1.toString());
-	model->chgCoeff(cardConstr,lambda,1.0);
-
-	//Add column (Explicit Master constraints)
-	Edge *myEdge;
-	GRBConstr explicitConstr;
-	vector<Edge*>::iterator eit = route->edges.begin();
-	while(eit != route->edges.end()){
-		myEdge = (*eit);
-
-		//Explicit constraints
-		c2.reset();
-		c2.setType(C_EXPLICIT);
-		c2.setStartJob(myEdge->getStartJob());
-		c2.setEndJob(myEdge->getEndJob());
-		c2.setTime(myEdge->getTime());
-		c2.setEquipmentType(eqType);
-
-		if(cHash.find(c2) == cHash.end()){
-			std::cout << "Adding Column " << v.toString() << ": Explicit master constraint didn't exist." << std::endl;
-			return false;
-		}
-
-		explicitConstr = model->getConstrByName(c2.toString());
-		model->chgCoeff(explicitConstr, lambda, -1.0);
-
-		eit++;
-	}
-
-	this->routeCount++;
-
-	//Update the model to include new column
-	model->update();
-	return true;
-}
-
-int Node::fixVarsByReducedCost(double maxRC)
-{
-	double epsilon = 1e-5;
-	int deletedVars = 0;
-	double rc = 0.0;
-	
-	GRBVar var;
-	VariableHash::iterator vit = vHash.begin();
-
-	while(vit != vHash.end()){
-		if(vit->first.getType() == V_X || vit->first.getType() == V_Y){
-			if(vit->first.getReducedCost() > maxRC){
-				var = model->getVarByName(vit->first.toString());
-				model->remove(var);
-				vHash.erase(vit++);
-				deletedVars++;
-			}else{
-				vit++;
-			}
-		}else{
-			vit++;
-		}
-	}
-
-	model->update();
-	return deletedVars;
-}
-
-int Node::cleanNode(int maxRoutes)
-{
-	int cont = 0;
-	vector<Variable> lambdas;
-
-	GRBVar lambda;
-
-	VariableHash::iterator vit = vHash.begin();
-	VariableHash::iterator evit = vHash.end();
-
-	for(; vit != evit; vit++){
-		if(vit->first.getType() == V_LAMBDA){
-			lambda = model->getVarByName(vit->first.toString());
-			if(lambda.get(GRB_IntAttr_VBasis) != GRB_BASIC){
-				lambdas.push_back(vit->first);
-			}
-		}
-	}
-
-	VariableRankComparator varRankComparator;
-	sort(lambdas.begin(),lambdas.end(),varRankComparator);
-		
-	vector<Variable>::iterator it = lambdas.begin();
-
-	while(it != lambdas.end()){
-		if(cont < maxRoutes){
-			cont++;
-		}else{
-			vit = vHash.find(*it);
-			vHash.erase(vit);			
-			lambda = model->getVarByName((*it).toString());
-			model->remove(lambda);
-			cont++;
-		}
-		it++;
-	}
-
-	lambdas.clear();
-	model->update();
-	return cont;
-}
-
-double Node::getVarLB(Variable v)
-{
-	GRBVar myVar;
-	VariableHash::iterator vit = vHash.find(v);
-	if(vit != vHash.end()){
-		myVar = model->getVarByName(v.toString());
-		return myVar.get(GRB_DoubleAttr_LB);
-	}
-
-	return -1;
-}
-
-double Node::getArcReducedCost(int sJob, int dJob, int time, int eqType)
-{
-	Constraint c;
-	c.setType(C_EXPLICIT);
-	c.setStartJob(sJob);
-	c.setEndJob(dJob);
-	c.setTime(time);
-	c.setEquipmentType(eqType);
-	
-	ConstraintHash::iterator cit = cHash.find(c);
-	if(cit != cHash.end()){ 
-		if(parameters->useDualStabilization()){
-			return alphaPi_e[cit->first.getId()];
-		}else{
-			GRBConstr myConstr = model->getConstrByName(c.toString());
-			return myConstr.get(GRB_DoubleAttr_Pi);
-		}
-	}
-
-	return 1e13;
-}
-
-double Node::getRouteUseReducedCost(int eqType)
-{
-	Constraint c;
-	c.setType(C_CARD);
-	c.setEquipmentType(eqType);
-
-	ConstraintHash::iterator cit = cHash.find(c);
-	if(cit != cHash.end()){
-		if(parameters->useDualStabilization()){
-			return alphaPi_e[cit->first.getId()];
-		}else{
-			GRBConstr myConstr = model->getConstrByName(c.toString());
-			return myConstr.get(GRB_DoubleAttr_Pi);
-		}
-	}
-
-	return 1e13;
-}
-
-double Node::verifyRouteCost(Route *r)
-{
-	double cost = 0;
-
-	Edge *e;
-	vector<Edge*>::iterator eit = r->edges.begin();
-	while(eit != r->edges.end()){
-		e = (*eit);
-		cost += getArcReducedCost(e->getStartJob(),e->getEndJob(),e->getTime(),r->getEquipmentType());
-
-		eit++;
-	}
-
-	return cost;
-}
-
-Solution* Node::getSolution()
-{
-	if(solution != nullptr)
-		delete solution;
-
-	solution = new Solution();
-
-	//Iterate through lambda variables
-	VariableHash::iterator vit = vHash.begin();
-	for(; vit != vHash.end(); vit++){
-		if(vit->first.getType() == V_X){
-			if(vit->first.getValue() > parameters->getEpsilon()){ //lambda is in current solution
-				solution->addEdge(vit->first.getStartJob(), vit->first.getEndJob(), vit->first.getTime(), vit->first.getArrivalTime(), vit->first.getEquipmentType());			
-			}
-		}
-	}
-	solution->setSolutionValue(Zlp);
-
-	return solution;
-}
-
-void Node::printSolution()
-{
-	Variable v;
-	
-	cout << "//------------------------------------------------//" << endl;
-	cout << "//----------------NEW SOLUTION--------------------//" << endl;
-	cout << "//------------------------------------------------//" << endl;
-	
-	cout << "Node id: " << nodeId << " - ObjValue: " << Zlp << endl;
-
-	VariableHash::iterator vit = vHash.begin();
-	VariableHash::iterator eit = vHash.end();
-
-	for(; vit != eit; vit++){
-		v = vit->first;
-		if(v.getType() == V_W) continue;
-		if(v.getValue() > 0.00001)
-			cout << v.toString() << " = " << v.getValue() << endl;
-	}
-	
-	cout << "//------------------------------------------------//" << endl;
-}
+#include "Node.h"
+#include "Bucket.h"
+#include "Route.h"
+#include "Solution.h"
+#include "CutPool.h"
+#include "NodeStore.h"
+
+#include <map>
+#include <set>
+#include <hash_map>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <sstream>
+#include <cstdio>
+
+NodeStore *Node::nodeStore = nullptr;
+
+Node::Node(int c, int e) : model(nullptr), nodeId(-1), depth(0), Zlp(1e13), routeCount(0), branchRhs(-1), parentZlp(0.0), estimate(0.0), storeRecord(-1)
+{
+	parameters = GlobalParameters::getInstance();
+	solution = nullptr;
+	cDual = c;
+	eDual = e;
+	initializePi();
+
+	//No time window restrictions at the root
+	startTimeLB = vector<int>(parameters->getNumJobs(), 0);
+	startTimeUB = vector<int>(parameters->getNumJobs(), parameters->getHorizonLength());
+}
+
+Node::Node(const Node &other) : solStatus(GRB_LOADED), vHash(other.vHash), cHash(other.cHash), 
+	nodeId(-1), depth(other.depth + 1), Zlp(1e13), routeCount(0), branchRhs(-1), parentZlp(other.Zlp), estimate(other.Zlp), 
+	startTimeLB(other.startTimeLB), startTimeUB(other.startTimeUB), 
+	arcMask(other.arcMask), fixedArcs(other.fixedArcs), pendingDecisions(other.pendingDecisions), 
+	pendingRemovals(other.pendingRemovals), decisions(other.decisions), storeRecord(-1), columns(other.columns), 
+	cuts(other.cuts), vBasis(other.vBasis), cBasis(other.cBasis)
+{
+	model = new GRBModel(*other.model);
+	if(nodeStore != nullptr) nodeStore->acquireRoutes(columns);
+	parameters = GlobalParameters::getInstance();
+	solution = nullptr;
+	cDual = other.cDual;
+	eDual = other.eDual;
+	initializePi();
+}
+
+Node::Node(const Node &other, GRBEnv *env, const string &modelFile) : solStatus(GRB_LOADED), vHash(other.vHash), cHash(other.cHash), 
+	nodeId(other.nodeId), depth(other.depth + 1), Zlp(1e13), routeCount(0), branchRhs(-1), parentZlp(other.Zlp), estimate(other.Zlp), 
+	startTimeLB(other.startTimeLB), startTimeUB(other.startTimeUB), 
+	arcMask(other.arcMask), fixedArcs(other.fixedArcs), pendingDecisions(other.pendingDecisions), 
+	pendingRemovals(other.pendingRemovals), decisions(other.decisions), storeRecord(-1), columns(other.columns), 
+	cuts(other.cuts), vBasis(other.vBasis), cBasis(other.cBasis)
+{
+	//Models can not be copied between environments, so the model is read from a file written by the caller
+	model = new GRBModel(*env, modelFile);
+	if(nodeStore != nullptr) nodeStore->acquireRoutes(columns);
+	parameters = GlobalParameters::getInstance();
+	solution = nullptr;
+	cDual = other.cDual;
+	eDual = other.eDual;
+	initializePi();
+}
+
+Node::~Node()
+{
+	vHash.clear();
+	cHash.clear();
+	delete model;
+	if(detachedFile != "") remove(detachedFile.c_str());
+
+	//A pruned stored node gives back its record, and every node its routes
+	if(nodeStore != nullptr){
+		if(isStored()) nodeStore->drop(this);
+		nodeStore->releaseRoutes(columns);
+	}
+}
+
+void Node::moveTo(GRBEnv *env, const string &modelFile)
+{
+	//Same node in another environment, only while no other thread uses the current one (the root node)
+	model->write(modelFile);
+	delete model;
+	model = new GRBModel(*env, modelFile);
+	remove(modelFile.c_str());
+}
+
+void Node::detach(const string &modelFile)
+{
+	//Called in the enviroment of the model, the node can then be attached by another worker
+	model->write(modelFile);
+	delete model;
+	model = nullptr;
+	detachedFile = modelFile;
+}
+
+void Node::attach(GRBEnv *env)
+{
+	model = new GRBModel(*env, detachedFile);
+	remove(detachedFile.c_str());
+	detachedFile = "";
+}
+
+void Node::release()
+{
+	//Only the bounds are kept in memory, the rest is rebuilt by restore
+	delete model;
+	model = nullptr;
+	vHash.clear();
+	cHash.clear();
+
+	vector<int>().swap(startTimeLB);
+	vector<int>().swap(startTimeUB);
+	vector<bool>().swap(arcMask);
+	vector<int>().swap(fixedArcs);
+	vector<pair<Variable,double>>().swap(pendingDecisions);
+	vector<Variable>().swap(pendingRemovals);
+	vector<pair<Variable,double>>().swap(decisions);
+	vector<ActiveCut>().swap(cuts);
+	vector<int>().swap(vBasis);
+	vector<int>().swap(cBasis);
+
+	alphaPi_c.resize(0);
+	feasiblePi_c.resize(0);
+	currentPi_c.resize(0);
+	alphaPi_e.resize(0);
+	currentPi_e.resize(0);
+	feasiblePi_e.resize(0);
+}
+
+void Node::restore(GRBModel *master, const VariableHash &v, const ConstraintHash &c)
+{
+	//Root state: master without columns nor branching decisions
+	model = new GRBModel(*master);
+	vHash = v;
+	cHash = c;
+	cuts.clear();
+	routeCount = 0;
+	solStatus = GRB_LOADED;
+
+	startTimeLB = vector<int>(parameters->getNumJobs(), 0);
+	startTimeUB = vector<int>(parameters->getNumJobs(), parameters->getHorizonLength());
+	initializePi();
+}
+
+int Node::solve()
+{
+	//model->write("modelo.lp");
+	if(vBasis.size() > 0) applyWarmStart();
+	model->optimize();
+	solStatus = model->get(GRB_IntAttr_Status);
+	
+	if(solStatus != GRB_OPTIMAL && solStatus != GRB_TIME_LIMIT && solStatus != GRB_SOLUTION_LIMIT)
+		return solStatus;
+
+	Zlp = model->get(GRB_DoubleAttr_ObjVal);
+	updateVariables(solStatus);
+	if(parameters->useDualStabilization()){
+		getCurrentPi();
+		calculateAlphaPi();
+	}
+	return solStatus;
+}
+
+int Node::solveRestrictedMIP(double timeLimit, double cutoff)
+{
+	GRBVar var;
+	VariableHash::iterator vit = vHash.begin();
+
+	//Columns and arcs must be integer, auxiliary variables are not allowed
+	for(; vit != vHash.end(); vit++){
+		var = model->getVarByName(vit->first.toString());
+		if(vit->first.getType() == V_LAMBDA || vit->first.getType() == V_X || vit->first.getType() == V_Y){
+			var.set(GRB_CharAttr_VType, GRB_INTEGER);
+		}else if(vit->first.getType() == V_BAUX || vit->first.getType() == V_FAUX){
+			var.set(GRB_DoubleAttr_UB, 0.0);
+		}
+	}
+	model->update();
+
+	GRBEnv myEnv = model->getEnv();
+	myEnv.set(GRB_DoubleParam_TimeLimit, timeLimit);
+	myEnv.set(GRB_DoubleParam_Cutoff, cutoff);
+
+	model->optimize();
+	solStatus = model->get(GRB_IntAttr_Status);
+
+	if(model->get(GRB_IntAttr_SolCount) == 0)
+		return (solStatus == GRB_TIME_LIMIT)? GRB_TIME_LIMIT : GRB_INFEASIBLE;
+
+	Zlp = model->get(GRB_DoubleAttr_ObjVal);
+	updateVariables(solStatus);
+
+	//The values are only integral up to the integrality tolerance (0.9999999), round them
+	double val;
+	isInteger = true;
+	for(vit = vHash.begin(); vit != vHash.end(); vit++){
+		val = floor(vit->first.getValue() + 0.5);
+		if(fabs(vit->first.getValue() - val) > parameters->getEpsilon()){
+			isInteger = false;
+		}else{
+			vit->first.setValue(val);
+			vit->first.setFractionality(fabs(val - 0.5));
+		}
+	}
+	return solStatus;
+}
+
+void Node::initializePi()
+{
+	alpha = 0.05;
+
+	alphaPi_c = valarray<double>(cDual);
+	feasiblePi_c = valarray<double>(cDual);
+	currentPi_c = valarray<double>(eDual);
+
+	alphaPi_e = valarray<double>(eDual);
+	currentPi_e = valarray<double>(eDual);
+	feasiblePi_e = valarray<double>(eDual);
+}
+
+void Node::getCurrentPi()
+{
+	double pi;
+
+	GRBConstr myConstr;
+
+	Constraint c;
+	ConstraintHash::iterator cit = cHash.begin();
+
+	while(cit != cHash.end()){
+		c = cit->first;
+		if(c.getType() == C_CARD){
+			myConstr = model->getConstrByName(c.toString());			
+			pi = myConstr.get(GRB_DoubleAttr_Pi); 
+			currentPi_c[c.getId()] = pi;
+		}else if(c.getType() == C_EXPLICIT){			
+			myConstr = model->getConstrByName(c.toString());			
+			pi = myConstr.get(GRB_DoubleAttr_Pi); 
+			currentPi_e[c.getId()] = pi;
+		}
+		cit++;
+	}
+}
+
+void Node::calculateAlphaPi()
+{
+	double alphaComp = 1 - alpha;
+
+	alphaPi_c = (alphaComp * feasiblePi_c) + (alpha * currentPi_c);
+	alphaPi_e = (alphaComp * feasiblePi_e) + (alpha * currentPi_e);
+}
+
+void Node::updatePi()
+{
+	feasiblePi_c = alphaPi_c;
+	feasiblePi_e = alphaPi_e;
+}
+
+double Node::getMaxPiDifference()
+{
+	double maxDiff;
+	valarray<double> diff1 = abs(feasiblePi_e - currentPi_e);
+	valarray<double> diff2 = abs(feasiblePi_c - currentPi_c);
+
+	maxDiff = max(diff1.max(),diff2.max());
+
+	return maxDiff;
+}
+
+void Node::updateVariables(int status)
+{
+	isInteger = true;
+
+	double val, rc;
+
+	GRBVar var;
+	VariableHash::iterator vit = vHash.begin();
+	VariableHash::iterator evit = vHash.end();
+
+	while(vit != evit){
+		var = model->getVarByName(vit->first.toString());
+
+		if(status == GRB_OPTIMAL && var.get(GRB_DoubleAttr_X) != 0){
+			vit->first.increaseRank();
+		}		
+
+		if(!model->get(GRB_IntAttr_IsMIP)){
+			rc = var.get(GRB_DoubleAttr_RC);			
+			vit->first.setReducedCost(rc);
+		}
+
+		val = var.get(GRB_DoubleAttr_X);
+		vit->first.setValue(val);
+		vit->first.setFractionality(fabs(val - 0.5));
+
+		if(val - floor(val) > parameters->getEpsilon()){
+			isInteger = false;
+		}
+
+		vit++;
+	}
+}
+
+vector<Variable> Node::getBranchingCandidates(BranchingLevel level)
+{
+	vector<Variable> candidates = vector<Variable>();
+	
+	Variable v;
+	double f;
+	double epsilon = parameters->getEpsilon();
+	VariableHash::iterator vit;
+
+	//Start time distribution of each job (time -> y value)
+	vector<map<int,double>> startTimes = vector<map<int,double>>(parameters->getNumJobs());
+	//Flow of each job pair ([eqType][sJob][dJob])
+	vector<vector<vector<double>>> flows;
+	if(level == BRANCH_FLOW){
+		flows = vector<vector<vector<double>>>(parameters->getNumEquipments(), 
+			vector<vector<double>>(parameters->getNumJobs(), vector<double>(parameters->getNumJobs(), 0.0)));
+	}
+
+	for(vit = vHash.begin(); vit != vHash.end(); vit++){
+		v = vit->first;
+
+		if(level == BRANCH_FLOW && v.getType() == V_X){
+			flows[v.getEquipmentType()][v.getStartJob()][v.getEndJob()] += v.getValue();
+			continue;
+		}
+
+		//Verify has a fractional value
+		f = v.getValue() - floor(v.getValue());
+		if(f < epsilon || f > 1 - epsilon) continue;
+
+		if(level == BRANCH_MACHINES && v.getType() == V_FAUX){
+			candidates.push_back(v);
+		}else if(level == BRANCH_TIME_WINDOW && v.getType() == V_Y){
+			startTimes[v.getStartJob()][v.getTime()] = v.getValue();
+		}else if(level == BRANCH_ARC && v.getType() == V_X){
+			candidates.push_back(v);
+		}
+	}
+
+	//Flow candidates: job pairs with fractional flow
+	if(level == BRANCH_FLOW){
+		for(int eqType=0; eqType < parameters->getNumEquipments(); eqType++){
+			for(int i=0; i < parameters->getNumJobs(); i++){
+				for(int j=0; j < parameters->getNumJobs(); j++){
+					f = flows[eqType][i][j] - floor(flows[eqType][i][j]);
+					if(f < epsilon || f > 1 - epsilon) continue;
+
+					//Flows from and to the depot are not bounded by 1
+					if(i == 0 || j == 0) continue;
+
+					v.reset();
+					v.setType(V_X);
+					v.setStartJob(i);
+					v.setEndJob(j);
+					v.setEquipmentTipe(eqType);
+					v.setValue(flows[eqType][i][j]);
+					candidates.push_back(v);
+				}
+			}
+		}
+	}
+
+	//Time window candidates: split the window of a job where its cumulated y is closest to 0.5
+	if(level == BRANCH_TIME_WINDOW){
+		for(int j=1; j < parameters->getNumJobs(); j++){
+			if(startTimes[j].size() == 0) continue;
+
+			double cumulated = 0.0;
+			double bestDiff = 1.0;
+			map<int,double>::iterator it = startTimes[j].begin();
+			for(; it != startTimes[j].end(); it++){
+				cumulated += it->second;
+				if(cumulated < epsilon || cumulated > 1 - epsilon) continue;
+
+				if(fabs(cumulated - 0.5) < bestDiff){
+					bestDiff = fabs(cumulated - 0.5);
+					v.reset();
+					v.setType(V_Y);
+					v.setStartJob(j);
+					v.setTime(it->first);
+					v.setValue(cumulated);
+				}
+			}
+
+			if(bestDiff < 1.0)
+				candidates.push_back(v);
+		}
+	}
+
+	return candidates;
+}
+
+BranchingLevel Node::getBranchingLevel(const Variable &v)
+{
+	switch(v.getType()){
+		case V_FAUX:
+			return BRANCH_MACHINES;
+		case V_Y:
+			return BRANCH_TIME_WINDOW;
+		case V_X:
+			return (v.getTime() == -1)? BRANCH_FLOW : BRANCH_ARC;
+		default:
+			return NUM_BRANCHING_LEVELS;
+	}
+}
+
+const Variable Node::getDivingCandidate()
+{
+	Variable v, lambda, x;
+	double maxLambda = 0.0, maxX = 0.0;
+	double epsilon = parameters->getEpsilon();
+
+	//Fractional lambda (or x arc) with value closest to 1
+	VariableHash::iterator vit;
+	for(vit = vHash.begin(); vit != vHash.end(); vit++){
+		v = vit->first;
+		if(v.getValue() < epsilon || v.getValue() > 1 - epsilon) continue;
+
+		if(v.getType() == V_LAMBDA && v.getValue() > maxLambda){
+			maxLambda = v.getValue();
+			lambda = v;
+		}else if(v.getType() == V_X && v.getValue() > maxX){
+			maxX = v.getValue();
+			x = v;
+		}
+	}
+
+	if(lambda.getType() == V_LAMBDA) return lambda;
+	return x;
+}
+
+const Variable Node::getRouteArc(const Variable &lambda)
+{
+	Variable v, arc;
+	Constraint c;
+	double minX = 2.0;
+
+	if(vHash.find(lambda) == vHash.end()) return arc;
+	GRBVar var = model->getVarByName(lambda.toString());
+
+	//Arc of the route (explicit row with a coefficient for lambda) least used by the current solution
+	VariableHash::iterator vit;
+	for(vit = vHash.begin(); vit != vHash.end(); vit++){
+		v = vit->first;
+		if(v.getType() != V_X || v.getTime() < 0 || v.getValue() >= minX) continue;
+
+		c.reset();
+		c.setType(C_EXPLICIT);
+		c.setStartJob(v.getStartJob());
+		c.setEndJob(v.getEndJob());
+		c.setTime(v.getTime());
+		c.setEquipmentType(v.getEquipmentType());
+		if(cHash.find(c) == cHash.end()) continue;
+
+		if(model->getCoeff(model->getConstrByName(c.toString()), var) != 0.0){
+			minX = v.getValue();
+			arc = v;
+		}
+	}
+
+	return arc;
+}
+
+bool Node::addBranchConstraint(Variable v, double rhs)
+{
+	//The pricing network is updated by the subproblem solver before the node is solved
+	pendingDecisions.push_back(make_pair(v, rhs));
+	decisions.push_back(make_pair(v, rhs));
+
+	switch(getBranchingLevel(v)){
+		case BRANCH_TIME_WINDOW:
+			return addTimeWindowBranch(v.getStartJob(), v.getTime(), rhs > 0.5);
+		case BRANCH_FLOW:
+			return addFlowBranch(v.getStartJob(), v.getEndJob(), v.getEquipmentType(), rhs > 0.5);
+		case BRANCH_MACHINES:
+			//Number of machines used is K - FAUX: round the auxiliary variable down or up
+			if(vHash.find(v) != vHash.end()){
+				GRBVar var = model->getVarByName(v.toString());
+				if(rhs > 0.5){
+					var.set(GRB_DoubleAttr_LB, ceil(v.getValue()));
+				}else{
+					var.set(GRB_DoubleAttr_UB, floor(v.getValue()));
+				}
+				model->update();
+				return true;
+			}
+			return false;
+		default:
+			break;
+	}
+
+	if(vHash.find(v) != vHash.end()){
+		GRBVar var = model->getVarByName(v.toString());
+		GRBLinExpr expr = 0;
+		expr += var;
+
+		model->addConstr(expr == rhs, "Branch_" + v.toString());
+		model->update();
+		return true;
+	}
+
+	return false;
+}
+
+bool Node::addTimeWindowBranch(int job, int time, bool early)
+{
+	Variable y;
+	GRBLinExpr expr = 0;
+
+	//Sum of y over the start times up to time
+	for(int t=startTimeLB[job]; t <= time && t <= startTimeUB[job]; t++){
+		y.reset();
+		y.setType(V_Y);
+		y.setStartJob(job);
+		y.setTime(t);
+
+		if(vHash.find(y) != vHash.end()){
+			expr += model->getVarByName(y.toString());
+		}
+	}
+
+	stringstream name;
+	name << "Branch_TW_" << job << "," << time;
+	model->addConstr(expr == (early? 1.0 : 0.0), name.str());
+	model->update();
+
+	//Window of the start times kept in the pricing network
+	if(early){
+		startTimeUB[job] = min(startTimeUB[job], time);
+	}else{
+		startTimeLB[job] = max(startTimeLB[job], time + 1);
+	}
+
+	return startTimeLB[job] <= startTimeUB[job];
+}
+
+bool Node::addFlowBranch(int sJob, int dJob, int eqType, bool used)
+{
+	Variable x;
+	GRBLinExpr expr = 0;
+
+	//Flow on the job pair over all time copies
+	VariableHash::iterator vit = vHash.begin();
+	for(; vit != vHash.end(); vit++){
+		x = vit->first;
+		if(x.getType() == V_X && x.getStartJob() == sJob && x.getEndJob() == dJob && x.getEquipmentType() == eqType){
+			expr += model->getVarByName(x.toString());
+		}
+	}
+
+	stringstream name;
+	name << "Branch_FLOW_" << sJob << "," << dJob << "," << eqType;
+	model->addConstr(expr == (used? 1.0 : 0.0), name.str());
+	model->update();
+
+	return true;
+}
+
+bool Node::addCut(Cut *cut)
+{
+	Variable x;
+	GRBLinExpr expr = 0;
+
+	if(cut->isRobust()){
+		vector<vector<bool>> inCut = vector<vector<bool>>(parameters->getNumJobs(), vector<bool>(parameters->getNumJobs(), false));
+		for(unsigned int k=0; k < cut->arcs.size(); k++){
+			inCut[cut->arcs[k].first][cut->arcs[k].second] = true;
+		}
+
+		//Flow on the job pairs of the cut over all time copies
+		VariableHash::iterator vit = vHash.begin();
+		for(; vit != vHash.end(); vit++){
+			x = vit->first;
+			if(x.getType() == V_X && x.getEquipmentType() == cut->getEquipmentType() && inCut[x.getStartJob()][x.getEndJob()]){
+				expr += model->getVarByName(x.toString());
+			}
+		}
+	}else{
+		//Columns of the equipment type by their visits to the cut jobs (later columns get it in addColumn)
+		VariableHash::iterator vit = vHash.begin();
+		for(; vit != vHash.end(); vit++){
+			if(vit->first.getType() != V_LAMBDA || vit->first.getEquipmentType() != cut->getEquipmentType()) continue;
+
+			GRBVar lambda = model->getVarByName(vit->first.toString());
+			int coefficient = cut->getRouteCoefficient(getColumnVisits(lambda));
+			if(coefficient > 0) expr += coefficient * lambda;
+		}
+	}
+
+	model->addConstr(expr, cut->getSense(), cut->getRhs(), Cut::getName(cut->getId()));
+	model->update();
+
+	ActiveCut active = {cut->getId(), (int)decisions.size(), 0, cut};
+	cuts.push_back(active);
+	return true;
+}
+
+bool Node::hasCut(int id)
+{
+	for(unsigned int k=0; k < cuts.size(); k++){
+		if(cuts[k].id == id) return true;
+	}
+	return false;
+}
+
+int Node::ageCuts(int maxAge)
+{
+	//Cuts that are not binding for more than maxAge rounds leave the model (they stay in the pool)
+	int removed = 0;
+	vector<ActiveCut> kept;
+
+	for(unsigned int k=0; k < cuts.size(); k++){
+		GRBConstr cons = model->getConstrByName(Cut::getName(cuts[k].id));
+		if(fabs(cons.get(GRB_DoubleAttr_Slack)) > parameters->getEpsilon()){
+			cuts[k].age++;
+		}else{
+			cuts[k].age = 0;
+		}
+
+		if(cuts[k].age > maxAge){
+			model->remove(cons);
+			removed++;
+		}else{
+			kept.push_back(cuts[k]);
+		}
+	}
+
+	if(removed > 0){
+		cuts = kept;
+		model->update();
+	}
+	return removed;
+}
+
+vector<Cut*> Node::getSubsetRowCuts(int eqType)
+{
+	vector<Cut*> subsetRow;
+	for(unsigned int k=0; k < cuts.size(); k++){
+		if(!cuts[k].cut->isRobust() && cuts[k].cut->getEquipmentType() == eqType) subsetRow.push_back(cuts[k].cut);
+	}
+	return subsetRow;
+}
+
+double Node::getCutDual(int id)
+{
+	GRBConstr cons = model->getConstrByName(Cut::getName(id));
+	return cons.get(GRB_DoubleAttr_Pi);
+}
+
+vector<pair<double,vector<int>>> Node::getRouteSolution(int eqType)
+{
+	//Routes with positive value and the jobs they visit
+	vector<pair<double,vector<int>>> routes;
+	VariableHash::iterator vit = vHash.begin();
+	for(; vit != vHash.end(); vit++){
+		if(vit->first.getType() != V_LAMBDA || vit->first.getEquipmentType() != eqType) continue;
+		if(vit->first.getValue() <= parameters->getEpsilon()) continue;
+
+		GRBVar lambda = model->getVarByName(vit->first.toString());
+		routes.push_back(make_pair(vit->first.getValue(), getColumnVisits(lambda)));
+	}
+	return routes;
+}
+
+vector<int> Node::getRouteVisits(Route *r)
+{
+	//Jobs left by the edges of the route, ordered by time
+	vector<pair<int,int>> departures;
+	vector<Edge*>::iterator eit = r->edges.begin();
+	for(; eit != r->edges.end(); eit++){
+		if((*eit)->getStartJob() != 0) departures.push_back(make_pair((*eit)->getTime(), (*eit)->getStartJob()));
+	}
+	sort(departures.begin(), departures.end());
+
+	vector<int> visits;
+	for(unsigned int k=0; k < departures.size(); k++){
+		visits.push_back(departures[k].second);
+	}
+	return visits;
+}
+
+vector<int> Node::getColumnVisits(GRBVar lambda)
+{
+	//Same as getRouteVisits, from the explicit master rows of the column
+	vector<pair<int,int>> departures;
+	GRBColumn column = model->getCol(lambda);
+	for(unsigned int k=0; k < column.size(); k++){
+		string name = column.getConstr(k).get(GRB_StringAttr_ConstrName);
+		int sJob, eJob, time, eqType;
+		if(sscanf(name.c_str(), "EXPLICIT_%d,%d,%d,%d", &sJob, &eJob, &time, &eqType) == 4 && sJob != 0){
+			departures.push_back(make_pair(time, sJob));
+		}
+	}
+	sort(departures.begin(), departures.end());
+
+	vector<int> visits;
+	for(unsigned int k=0; k < departures.size(); k++){
+		visits.push_back(departures[k].second);
+	}
+	return visits;
+}
+
+vector<vector<vector<double>>> Node::getArcFlows()
+{
+	//Flow of each job pair over all time copies ([eqType][sJob][dJob])
+	vector<vector<vector<double>>> flows = vector<vector<vector<double>>>(parameters->getNumEquipments(), 
+		vector<vector<double>>(parameters->getNumJobs(), vector<double>(parameters->getNumJobs(), 0.0)));
+
+	VariableHash::iterator vit = vHash.begin();
+	for(; vit != vHash.end(); vit++){
+		if(vit->first.getType() == V_X){
+			flows[vit->first.getEquipmentType()][vit->first.getStartJob()][vit->first.getEndJob()] += vit->first.getValue();
+		}
+	}
+	return flows;
+}
+
+bool Node::addColumn(Route *route)
+{	
+	Variable v;
+
+	Constraint c1, c2;
+	ConstraintHash::iterator cit1, cit2;
+
+	int routeNumber = route->getRouteNumber();
+	int eqType = route->getEquipmentType();
+
+	//Create lambda variable
+	v.reset();
+	v.setType(V_LAMBDA);
+	v.setRouteNumber(routeNumber);
+	v.setEquipmentTipe(eqType);
+
+	if(vHash.find(v) != vHash.end()){
+		std::cout << "Adding Column " << v.toString() << ": Lambda variable already existed! " << std::endl;
+		return false;
+	}
+
+	vHash[v] = true;
+	GRBVar lambda = model->addVar(0.0,GRB_INFINITY,0.0,GRB_CONTINUOUS,v.toString());
+	model->update(); 
+	columns.push_back(routeNumber);
+	if(nodeStore != nullptr) nodeStore->acquireRoute(route);
+
+	//Add column (Card constraints)
+	c1.reset();
+	c1.setType(C_CARD);
+	c1.setEquipmentType(eqType);
+
+	if(cHash.find(c1) == cHash.end()){
+		std::cout << "Adding Column " << v.toString() << ": Cardinality constraint didn't exist." << std::endl;
+		return false;
+	}
+	GRBConstr cardConstr = model->getConstrByName(c1.toString());
+	model->chgCoeff(cardConstr,lambda,1.0);
+
+	//Add column (Explicit Master constraints)
+	Edge *myEdge;
+	GRBConstr explicitConstr;
+	vector<Edge*>::iterator eit = route->edges.begin();
+	while(eit != route->edges.end()){
+		myEdge = (*eit);
+
+		//Explicit constraints
+		c2.reset();
+		c2.setType(C_EXPLICIT);
+		c2.setStartJob(myEdge->getStartJob());
+		c2.setEndJob(myEdge->getEndJob());
+		c2.setTime(myEdge->getTime());
+		c2.setEquipmentType(eqType);
+
+		if(cHash.find(c2) == cHash.end()){
+			std::cout << "Adding Column " << v.toString() << ": Explicit master constraint didn't exist." << std::endl;
+			return false;
+		}
+
+		explicitConstr = model->getConstrByName(c2.toString());
+		model->chgCoeff(explicitConstr, lambda, -1.0);
+
+		eit++;
+	}
+
+	//Subset row cuts of the equipment type
+	vector<Cut*> subsetRow = getSubsetRowCuts(eqType);
+	if(subsetRow.size() > 0){
+		vector<int> visits = getRouteVisits(route);
+		for(unsigned int k=0; k < subsetRow.size(); k++){
+			int coefficient = subsetRow[k]->getRouteCoefficient(visits);
+			if(coefficient > 0) model->chgCoeff(model->getConstrByName(Cut::getName(subsetRow[k]->getId())), lambda, coefficient);
+		}
+	}
+
+	this->routeCount++;
+
+	//Update the model to include new column
+	model->update();
+	return true;
+}
+
+int Node::fixVarsByReducedCost(double maxRC)
+{
+	double epsilon = parameters->getEpsilon();
+	int fixedVars = 0;
+	
+	GRBVar var;
+	VariableHash::iterator vit = vHash.begin();
+
+	//Variables stay in the master (fixed to 0) so the explicit master constraints of their arcs still exist
+	for(; vit != vHash.end(); vit++){
+		if(vit->first.getType() != V_X && vit->first.getType() != V_Y) continue;
+		if(vit->first.getReducedCost() <= maxRC + epsilon) continue;
+
+		var = model->getVarByName(vit->first.toString());
+		if(var.get(GRB_DoubleAttr_UB) > 0){
+			var.set(GRB_DoubleAttr_UB, 0.0);
+			//The arc (or the start time) is also removed from the pricing network
+			pendingRemovals.push_back(vit->first);
+			fixedVars++;
+		}
+	}
+
+	model->update();
+	return fixedVars;
+}
+
+size_t Node::getMemoryEstimate()
+{
+	size_t bytes = sizeof(Node) + columns.size() * sizeof(int);
+	if(model == nullptr) return bytes;
+
+	//Gurobi model: coefficients, variables and constraints
+	bytes += (size_t)model->get(GRB_IntAttr_NumNZs) * 16;
+	bytes += (size_t)(model->get(GRB_IntAttr_NumVars) + model->get(GRB_IntAttr_NumConstrs)) * 64;
+
+	//Hash maps and pricing network mask
+	bytes += vHash.size() * (sizeof(Variable) + 4 * sizeof(double) + sizeof(int));
+	bytes += cHash.size() * sizeof(Constraint);
+	bytes += arcMask.size() / 8;
+
+	return bytes;
+}
+
+int Node::cleanNode(int maxRoutes)
+{
+	int cont = 0;
+	vector<Variable> lambdas;
+
+	GRBVar lambda;
+
+	VariableHash::iterator vit = vHash.begin();
+	VariableHash::iterator evit = vHash.end();
+
+	for(; vit != evit; vit++){
+		if(vit->first.getType() == V_LAMBDA){
+			lambda = model->getVarByName(vit->first.toString());
+			if(lambda.get(GRB_IntAttr_VBasis) != GRB_BASIC){
+				lambdas.push_back(vit->first);
+			}
+		}
+	}
+
+	VariableRankComparator varRankComparator;
+	sort(lambdas.begin(),lambdas.end(),varRankComparator);
+		
+	vector<Variable>::iterator it = lambdas.begin();
+	set<int> removed;
+
+	while(it != lambdas.end()){
+		if(cont < maxRoutes){
+			cont++;
+		}else{
+			vit = vHash.find(*it);
+			vHash.erase(vit);			
+			lambda = model->getVarByName((*it).toString());
+			model->remove(lambda);
+			removed.insert(it->getRouteNumber());
+			cont++;
+		}
+		it++;
+	}
+
+	//The removed columns give back their routes
+	if(removed.size() > 0){
+		vector<int> kept, released;
+		for(unsigned int i=0; i < columns.size(); i++){
+			if(removed.count(columns[i]) > 0) released.push_back(columns[i]);
+			else kept.push_back(columns[i]);
+		}
+		columns.swap(kept);
+		if(nodeStore != nullptr) nodeStore->releaseRoutes(released);
+	}
+
+	lambdas.clear();
+	model->update();
+	return cont;
+}
+
+void Node::saveBasis()
+{
+	//Cleaning and fixing only touched nonbasic columns, so the basis is recovered without iterations
+	model->optimize();
+	if(model->get(GRB_IntAttr_Status) != GRB_OPTIMAL) return;
+
+	int numVars = model->get(GRB_IntAttr_NumVars);
+	int numConstrs = model->get(GRB_IntAttr_NumConstrs);
+	GRBVar *vars = model->getVars();
+	GRBConstr *constrs = model->getConstrs();
+
+	int *vb = model->get(GRB_IntAttr_VBasis, vars, numVars);
+	int *cb = model->get(GRB_IntAttr_CBasis, constrs, numConstrs);
+	vBasis = vector<int>(vb, vb + numVars);
+	cBasis = vector<int>(cb, cb + numConstrs);
+
+	delete[] vb;
+	delete[] cb;
+	delete[] vars;
+	delete[] constrs;
+}
+
+void Node::applyWarmStart()
+{
+	int numVars = model->get(GRB_IntAttr_NumVars);
+	int numConstrs = model->get(GRB_IntAttr_NumConstrs);
+
+	//Columns changed since the basis was saved
+	if(numVars != (int)vBasis.size() || numConstrs < (int)cBasis.size()){
+		vector<int>().swap(vBasis);
+		vector<int>().swap(cBasis);
+		return;
+	}
+
+	GRBVar *vars = model->getVars();
+	GRBConstr *constrs = model->getConstrs();
+
+	//Rebuilt nodes lose the reduced cost fixings: a variable can not be at an infinite upper bound
+	double *ub = model->get(GRB_DoubleAttr_UB, vars, numVars);
+	for(int i=0; i < numVars; i++){
+		if(vBasis[i] == GRB_NONBASIC_UPPER && ub[i] >= GRB_INFINITY) vBasis[i] = GRB_NONBASIC_LOWER;
+	}
+
+	//Branching rows added after the basis was saved are basic
+	cBasis.resize(numConstrs, GRB_BASIC);
+
+	model->set(GRB_IntAttr_VBasis, vars, &vBasis[0], numVars);
+	model->set(GRB_IntAttr_CBasis, constrs, &cBasis[0], numConstrs);
+
+	delete[] ub;
+	delete[] vars;
+	delete[] constrs;
+	vector<int>().swap(vBasis);
+	vector<int>().swap(cBasis);
+}
+
+double Node::getArcReducedCost(int sJob, int dJob, int time, int eqType)
+{
+	Constraint c;
+	c.setType(C_EXPLICIT);
+	c.setStartJob(sJob);
+	c.setEndJob(dJob);
+	c.setTime(time);
+	c.setEquipmentType(eqType);
+	
+	ConstraintHash::iterator cit = cHash.find(c);
+	if(cit != cHash.end()){ 
+		if(parameters->useDualStabilization()){
+			return alphaPi_e[cit->first.getId()];
+		}else{
+			GRBConstr myConstr = model->getConstrByName(c.toString());
+			return myConstr.get(GRB_DoubleAttr_Pi);
+		}
+	}
+
+	return 1e13;
+}
+
+double Node::getRouteUseReducedCost(int eqType)
+{
+	Constraint c;
+	c.setType(C_CARD);
+	c.setEquipmentType(eqType);
+
+	ConstraintHash::iterator cit = cHash.find(c);
+	if(cit != cHash.end()){
+		if(parameters->useDualStabilization()){
+			return alphaPi_e[cit->first.getId()];
+		}else{
+			GRBConstr myConstr = model->getConstrByName(c.toString());
+			return myConstr.get(GRB_DoubleAttr_Pi);
+		}
+	}
+
+	return 1e13;
+}
+
+double Node::verifyRouteCost(Route *r)
+{
+	double cost = 0;
+
+	Edge *e;
+	vector<Edge*>::iterator eit = r->edges.begin();
+	while(eit != r->edges.end()){
+		e = (*eit);
+		cost += getArcReducedCost(e->getStartJob(),e->getEndJob(),e->getTime(),r->getEquipmentType());
+
+		eit++;
+	}
+
+	//Subset row cuts (their duals are not positive)
+	vector<Cut*> subsetRow = getSubsetRowCuts(r->getEquipmentType());
+	if(subsetRow.size() > 0){
+		vector<int> visits = getRouteVisits(r);
+		for(unsigned int k=0; k < subsetRow.size(); k++){
+			cost -= getCutDual(subsetRow[k]->getId()) * subsetRow[k]->getRouteCoefficient(visits);
+		}
+	}
+
+	return cost;
+}
+
+Solution* Node::getSolution()
+{
+	if(solution != nullptr)
+		delete solution;
+
+	solution = new Solution();
+
+	//Iterate through lambda variables
+	VariableHash::iterator vit = vHash.begin();
+	for(; vit != vHash.end(); vit++){
+		if(vit->first.getType() == V_X){
+			if(vit->first.getValue() > parameters->getEpsilon()){ //lambda is in current solution
+				solution->addEdge(vit->first.getStartJob(), vit->first.getEndJob(), vit->first.getTime(), vit->first.getArrivalTime(), vit->first.getEquipmentType());			
+			}
+		}
+	}
+	solution->setSolutionValue(Zlp);
+
+	return solution;
+}
+
+void Node::printSolution()
+{
+	Variable v;
+	
+	cout << "//------------------------------------------------//" << endl;
+	cout << "//----------------NEW SOLUTION--------------------//" << endl;
+	cout << "//------------------------------------------------//" << endl;
+	
+	cout << "Node id: " << nodeId << " - ObjValue: " << Zlp << endl;
+
+	VariableHash::iterator vit = vHash.begin();
+	VariableHash::iterator eit = vHash.end();
+
+	for(; vit != eit; vit++){
+		v = vit->first;
+		if(v.getType() == V_W) continue;
+		if(v.getValue() > 0.00001)
+			cout << v.toString() << " = " << v.getValue() << endl;
+	}
+	
+	cout << "//------------------------------------------------//" << endl;
+}
@@ -1,95 +1,207 @@
-#pragma once
-
-#include "gurobi_c++.h"
-#include "Variable.h"
-#include "Constraint.h"
-#include "GlobalParameters.h"
-
-#include <map>
-#include <valarray>
-
-#ifdef DEBUG
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
-#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
-#define new DEBUG_NEW
-#endif
-
-using namespace std;
-
-class Route;
-class Solution;
-
-class Node
-{
-public:
-	Node(int c, int e);
-	Node(const Node &node);
-	~Node();
-	
-	int solve();
-	int solStatus;
-	
-	VariableHash vHash;
-	ConstraintHash cHash;	
-	
-	int cDual, eDual;	
-	void updatePi();
-	double getMaxPiDifference();
-
-	//Get Methods
-	GRBModel *getModel(){ return model; }
-	int getNodeId(){ return nodeId; }	
-	double getZLP(){ return Zlp; }
-	double getVarLB(Variable v);
-	int getRouteCount(){ return routeCount; }
-
-	double getArcReducedCost(int sJob, int dJob, int time, int eqType);
-	double getRouteUseReducedCost(int eqType);
-
-
-	//Set Methods
-	void setNodeId(int id){ nodeId = id; }
-	void setModel(GRBModel *m){	model = new GRBModel(*m); }
-	void setVHash(VariableHash hash){ vHash = hash; }
-	void setCHash(ConstraintHash hash){ cHash = hash; }
-	
-	//Other Methods 
-	const Variable getMostFractional();
-	bool isIntegerSolution(){ return isInteger; }
-
-	bool addColumn(Route *r);
-	bool addBranchConstraint(Variable v, double rhs);
-	int fixVarsByReducedCost(double maxRC);
-	int cleanNode(int maxRoutes);
-	void printSolution();
-
-	double verifyRouteCost(Route *r);
-	Solution *getSolution();
-
-private:
-	GRBModel *model;
-	GlobalParameters *parameters;
-	Solution *solution;
-		
-	int nodeId;
-	double Zlp;
-	bool isInteger;
-	int routeCount;
-
-	void updateVariables(int status);
-	
-	//dual stabilization	
-	double alpha;
-	void initializePi();
-	void getCurrentPi();
-	void calculateAlphaPi();
-
-	valarray<double> alphaPi_e;
-	valarray<double> feasiblePi_e; //for explicit master constraints
-	valarray<double> currentPi_e; //for explicit master constraints
-	valarray<double> alphaPi_c;
-	valarray<double> feasiblePi_c; //for convex constraints
-	valarray<double> currentPi_c; //for convex constraints
+#pragma once
+
+#include "gurobi_c++.h"
+#include "Variable.h"
+#include "Constraint.h"
+#include "GlobalParameters.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <valarray>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+class Route;
+class Solution;
+class Cut;
+class NodeStore;
+
+//Branching hierarchy levels
+enum BranchingLevel
+{
+	BRANCH_MACHINES = 0,	//number of machines used per equipment type (FAUX)
+	BRANCH_FLOW,			//flow on a job pair summed over all times (X with time -1)
+	BRANCH_TIME_WINDOW,		//start time window of a job (Y)
+	BRANCH_ARC,				//single time indexed arc (X)
+	NUM_BRANCHING_LEVELS
+};
+
+//Cut of the pool in the model of a node
+struct ActiveCut
+{
+	int id;
+	int position;	//branching decisions of the node when the cut was added (to rebuild it in order)
+	int age;		//consecutive rounds without being binding
+	Cut *cut;		//owned by the cut pool
+};
+
+class Node
+{
+public:
+	Node(int c, int e);
+	Node(const Node &node);
+	Node(const Node &node, GRBEnv *env, const string &modelFile);
+	~Node();
+
+	void moveTo(GRBEnv *env, const string &modelFile);
+	void detach(const string &modelFile);
+	void attach(GRBEnv *env);
+	void release();
+	void restore(GRBModel *master, const VariableHash &v, const ConstraintHash &c);
+	
+	int solve();
+	int solStatus;
+	
+	VariableHash vHash;
+	ConstraintHash cHash;	
+	
+	int cDual, eDual;	
+	void updatePi();
+	double getMaxPiDifference();
+
+	//Get Methods
+	GRBModel *getModel(){ return model; }
+	int getNodeId(){ return nodeId; }	
+	int getDepth(){ return depth; }
+	double getZLP(){ return Zlp; }
+	int getRouteCount(){ return routeCount; }
+	const Variable getBranchVariable(){ return branchVariable; }
+	double getBranchRhs(){ return branchRhs; }
+	double getParentZLP(){ return parentZlp; }
+	double getEstimate(){ return estimate; }
+	size_t getMemoryEstimate();
+	int getStartTimeLB(int job){ return startTimeLB[job]; }
+	int getStartTimeUB(int job){ return startTimeUB[job]; }
+	vector<bool> &getArcMask(){ return arcMask; }
+	vector<int> &getFixedArcs(){ return fixedArcs; }
+	vector<pair<Variable,double>> &getPendingDecisions(){ return pendingDecisions; }
+	vector<Variable> &getPendingRemovals(){ return pendingRemovals; }
+	vector<pair<Variable,double>> &getDecisions(){ return decisions; }
+	vector<int> getColumnNumbers(){ return columns; }
+	vector<int> &getColumns(){ return columns; }
+	vector<ActiveCut> &getCuts(){ return cuts; }
+	vector<Cut*> getSubsetRowCuts(int eqType);
+	double getCutDual(int id);
+	vector<vector<vector<double>>> getArcFlows();
+	vector<pair<double,vector<int>>> getRouteSolution(int eqType);
+	vector<int> &getVBasis(){ return vBasis; }
+	vector<int> &getCBasis(){ return cBasis; }
+	bool isStored(){ return storeRecord >= 0; }
+	bool isDetached(){ return model == nullptr && detachedFile != ""; }
+	int getStoreRecord(){ return storeRecord; }
+
+	double getArcReducedCost(int sJob, int dJob, int time, int eqType);
+	double getRouteUseReducedCost(int eqType);
+
+
+	//Set Methods
+	void setNodeId(int id){ nodeId = id; }
+	void setDepth(int d){ depth = d; }
+	void setModel(GRBModel *m){	model = new GRBModel(*m); }
+	void setVHash(VariableHash hash){ vHash = hash; }
+	void setCHash(ConstraintHash hash){ cHash = hash; }
+	void setBranch(Variable v, double rhs, double zlp){ branchVariable = v; branchRhs = rhs; parentZlp = zlp; }
+	void setEstimate(double e){ estimate = e; }
+	void setStoreRecord(int record){ storeRecord = record; }
+	static void setNodeStore(NodeStore *store){ nodeStore = store; }
+	void setWarmStart(const vector<int> &vb, const vector<int> &cb){ vBasis = vb; cBasis = cb; }
+	
+	//Other Methods 
+	vector<Variable> getBranchingCandidates(BranchingLevel level);
+	static BranchingLevel getBranchingLevel(const Variable &v);
+	const Variable getDivingCandidate();
+	const Variable getRouteArc(const Variable &lambda);
+	bool isIntegerSolution(){ return isInteger; }
+	int getSolutionCount(){ return model->get(GRB_IntAttr_SolCount); }
+
+	int solveRestrictedMIP(double timeLimit, double cutoff);
+
+	bool addColumn(Route *r);
+	bool addBranchConstraint(Variable v, double rhs);
+	bool addTimeWindowBranch(int job, int time, bool early);
+	bool addFlowBranch(int sJob, int dJob, int eqType, bool used);
+	bool addCut(Cut *cut);
+	bool hasCut(int id);
+	int ageCuts(int maxAge);
+	int fixVarsByReducedCost(double maxRC);
+	int cleanNode(int maxRoutes);
+	void saveBasis();
+	void printSolution();
+
+	double verifyRouteCost(Route *r);
+	Solution *getSolution();
+
+private:
+	GRBModel *model;
+	GlobalParameters *parameters;
+	Solution *solution;
+		
+	int nodeId;
+	int depth;
+	double Zlp;
+	bool isInteger;
+	int routeCount;
+
+	//Branching decision that created this node (for pseudo costs)
+	Variable branchVariable;
+	double branchRhs;
+	double parentZlp;
+	double estimate;
+
+	//Start time window of each job imposed by time window branching
+	vector<int> startTimeLB;
+	vector<int> startTimeUB;
+
+	//Pricing network of the node: removed arcs (by arc id) and arcs fixed to 1 by branching
+	vector<bool> arcMask;
+	vector<int> fixedArcs;
+	//Branching decisions and reduced cost fixings not yet applied to the arc mask
+	vector<pair<Variable,double>> pendingDecisions;
+	vector<Variable> pendingRemovals;
+
+	//All branching decisions from the root, to rebuild the node once stored (see NodeStore)
+	vector<pair<Variable,double>> decisions;
+	int storeRecord;
+
+	//Route numbers of the columns in the order of the model. Each one holds a reference to the route in the node store.
+	//Checkpoints read them from other threads, so they are kept without querying the model
+	vector<int> columns;
+	static NodeStore *nodeStore;
+
+	//Model file of a node detached from its enviroment (see NodePool)
+	string detachedFile;
+
+	//Cuts of the pool in the model, in the order they were added
+	vector<ActiveCut> cuts;
+
+	//Warm start basis inherited from the parent (new rows are basic)
+	vector<int> vBasis;
+	vector<int> cBasis;
+	void applyWarmStart();
+
+	void updateVariables(int status);
+	vector<int> getRouteVisits(Route *r);
+	vector<int> getColumnVisits(GRBVar lambda);
+	
+	//dual stabilization	
+	double alpha;
+	void initializePi();
+	void getCurrentPi();
+	void calculateAlphaPi();
+
+	valarray<double> alphaPi_e;
+	valarray<double> feasiblePi_e; //for explicit master constraints
+	valarray<double> currentPi_e; //for explicit master constraints
+	valarray<double> alphaPi_c;
+	valarray<double> feasiblePi_c; //for convex constraints
+	valarray<double> currentPi_c; //for convex constraints
 };
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "NodePool.h"
+
+#include <algorithm>
+#include <sstream>
+
+NodePool::NodePool(int numWorkers, NodeSelection s) : requests(0), donations(0), nodeStore(nullptr), storeMemory(0.0), pending(0), steals(0)
+{
+	queues = vector<NodeQueue*>(numWorkers);
+	locks = vector<omp_lock_t>(numWorkers);
+	evaluating = vector<double>(numWorkers, 1e13);
+	requesting = vector<bool>(numWorkers, false);
+
+	for(int w=0; w < numWorkers; w++){
+		queues[w] = new NodeQueue(s);
+		omp_init_lock(&locks[w]);
+	}
+	omp_init_lock(&donationLock);
+}
+
+NodePool::~NodePool()
+{
+	for(unsigned int w=0; w < queues.size(); w++){
+		delete queues[w];
+		omp_destroy_lock(&locks[w]);
+	}
+	queues.clear();
+	locks.clear();
+
+	for(unsigned int k=0; k < donated.size(); k++){
+		delete donated[k];
+	}
+	donated.clear();
+	omp_destroy_lock(&donationLock);
+}
+
+void NodePool::push(int worker, Node *node)
+{
+	#pragma omp atomic
+	pending++;
+
+	omp_set_lock(&locks[worker]);
+	queues[worker]->push(node);
+	if(nodeStore != nullptr && storeMemory > 0){
+		queues[worker]->offload(nodeStore, storeMemory / queues.size());
+	}
+	omp_unset_lock(&locks[worker]);
+
+	donate(worker);
+}
+
+void NodePool::donate(int worker)
+{
+	int wanted;
+	omp_set_lock(&donationLock);
+	wanted = requests - donated.size();
+	omp_unset_lock(&donationLock);
+
+	//The owner keeps one node and moves the others out of its enviroment, in its own thread
+	while(wanted > 0){
+		Node *node = nullptr;
+		omp_set_lock(&locks[worker]);
+		if(queues[worker]->size() > 1) node = queues[worker]->steal();
+		omp_unset_lock(&locks[worker]);
+		if(node == nullptr) break;
+
+		omp_set_lock(&donationLock);
+		stringstream modelFile;
+		modelFile << "donated_" << donations++ << ".mps";
+		omp_unset_lock(&donationLock);
+		if(!node->isStored()) node->detach(modelFile.str());
+
+		omp_set_lock(&donationLock);
+		donated.push_back(node);
+		omp_unset_lock(&donationLock);
+		wanted--;
+	}
+}
+
+Node *NodePool::pop(int worker, int &owner)
+{
+	Node *node = nullptr;
+
+	donate(worker);
+
+	omp_set_lock(&locks[worker]);
+	if(!queues[worker]->isEmpty()){
+		node = queues[worker]->pop();
+		owner = worker;
+	}
+	omp_unset_lock(&locks[worker]);
+
+	//Take a node given away by another worker, or ask for one (the caller backs off and tries again)
+	if(node == nullptr){
+		omp_set_lock(&donationLock);
+		if(donated.size() > 0){
+			node = donated.back();
+			donated.pop_back();
+			owner = -1;
+			if(requesting[worker]) requests--;
+			requesting[worker] = false;
+		}else if(!requesting[worker]){
+			requesting[worker] = true;
+			requests++;
+		}
+		omp_unset_lock(&donationLock);
+		if(node == nullptr) return nullptr;
+
+		#pragma omp atomic
+		steals++;
+	}
+
+	#pragma omp critical(nodePoolBound)
+	evaluating[worker] = node->getParentZLP();
+
+	return node;
+}
+
+void NodePool::nodeDone(int worker)
+{
+	#pragma omp critical(nodePoolBound)
+	evaluating[worker] = 1e13;
+
+	//Children are pushed before, so pending only reaches 0 when the tree is exhausted
+	#pragma omp atomic
+	pending--;
+}
+
+int NodePool::pruneByBound(int worker, double ZInc)
+{
+	int pruned = 0;
+
+	//Only the nodes of this worker and the donated ones, the other workers prune theirs when they pop them
+	omp_set_lock(&locks[worker]);
+	pruned += queues[worker]->pruneByBound(ZInc);
+	omp_unset_lock(&locks[worker]);
+
+	omp_set_lock(&donationLock);
+	for(int k = donated.size() - 1; k >= 0; k--){
+		if(donated[k]->getParentZLP() >= ZInc - GlobalParameters::getInstance()->getEpsilon()){
+			delete donated[k];
+			donated.erase(donated.begin() + k);
+			pruned++;
+		}
+	}
+	omp_unset_lock(&donationLock);
+
+	#pragma omp atomic
+	pending -= pruned;
+
+	return pruned;
+}
+
+int NodePool::writeNodes(ostream &out)
+{
+	int count = 0;
+
+	for(unsigned int w=0; w < queues.size(); w++){
+		omp_set_lock(&locks[w]);
+		for(int k=0; k < queues[w]->size(); k++){
+			nodeStore->writeNode(out, queues[w]->getNode(k));
+			count++;
+		}
+		omp_unset_lock(&locks[w]);
+	}
+
+	omp_set_lock(&donationLock);
+	for(unsigned int k=0; k < donated.size(); k++){
+		nodeStore->writeNode(out, donated[k]);
+		count++;
+	}
+	omp_unset_lock(&donationLock);
+
+	return count;
+}
+
+int NodePool::size()
+{
+	int total = 0;
+
+	for(unsigned int w=0; w < queues.size(); w++){
+		omp_set_lock(&locks[w]);
+		total += queues[w]->size();
+		omp_unset_lock(&locks[w]);
+	}
+
+	omp_set_lock(&donationLock);
+	total += donated.size();
+	omp_unset_lock(&donationLock);
+
+	return total;
+}
+
+bool NodePool::isFinished()
+{
+	int open;
+
+	#pragma omp flush(pending)
+	open = pending;
+
+	return open == 0;
+}
+
+double NodePool::getBound()
+{
+	double bound = 1e13;
+
+	for(unsigned int w=0; w < queues.size(); w++){
+		omp_set_lock(&locks[w]);
+		bound = min(bound, queues[w]->getBound());
+		omp_unset_lock(&locks[w]);
+	}
+
+	omp_set_lock(&donationLock);
+	for(unsigned int k=0; k < donated.size(); k++){
+		bound = min(bound, donated[k]->getParentZLP());
+	}
+	omp_unset_lock(&donationLock);
+
+	#pragma omp critical(nodePoolBound)
+	for(unsigned int w=0; w < evaluating.size(); w++){
+		bound = min(bound, evaluating[w]);
+	}
+
+	return bound;
+}
+
+double NodePool::getMemoryUsage()
+{
+	double total = 0.0;
+
+	for(unsigned int w=0; w < queues.size(); w++){
+		omp_set_lock(&locks[w]);
+		total += queues[w]->getMemoryUsage();
+		omp_unset_lock(&locks[w]);
+	}
+
+	return total;
+}
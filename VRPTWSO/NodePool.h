@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Node.h"
+#include "NodeQueue.h"
+
+#include <vector>
+#include <omp.h>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+/**
+* Open nodes of the parallel tree search.
+* Every worker has its own NodeQueue, whose nodes live in the Gurobi enviroment of the worker.
+* Enviroments are not thread safe, so a worker with an empty queue never touches the nodes of another one:
+* it posts a request, and the owners detach nodes from their enviroments (see Node::detach) when they push
+* or pop. Detached and stored nodes can be taken by any worker.
+* The search ends when no node is open nor being evaluated.
+*/
+class NodePool
+{
+public:
+	NodePool(int numWorkers, NodeSelection s);
+	~NodePool();
+
+	void push(int worker, Node *node);
+	void setNodeStore(NodeStore *store, double maxMemory){ nodeStore = store; storeMemory = maxMemory; }
+	Node *pop(int worker, int &owner);
+	void nodeDone(int worker);
+	int pruneByBound(int worker, double ZInc);
+	int writeNodes(ostream &out);
+
+	//GET METHODS
+	int size();
+	bool isFinished();
+	double getBound();
+	double getMemoryUsage();
+	int getSteals(){ return steals; }
+
+private:
+	vector<NodeQueue*> queues;
+	vector<omp_lock_t> locks;
+
+	//Nodes given away by their owners, and workers waiting for one
+	vector<Node*> donated;
+	vector<bool> requesting;
+	int requests;
+	int donations;
+	omp_lock_t donationLock;
+	void donate(int worker);
+
+	//Nodes beyond storeMemory MB (split among the queues) are written to disk
+	NodeStore *nodeStore;
+	double storeMemory;
+
+	//Bound of the node each worker is evaluating (1e13 if idle)
+	vector<double> evaluating;
+	//Open nodes plus nodes being evaluated
+	int pending;
+	int steals;
+};
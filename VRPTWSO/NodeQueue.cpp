@@ -0,0 +1,164 @@
+#include "NodeQueue.h"
+
+#include <iostream>
+#include <algorithm>
+
+NodeQueue::NodeQueue(NodeSelection s) : selection(s), totalMemory(0), selections(0), plungeDepth(0), lastPushed(0), dfsMode(false)
+{
+	parameters = GlobalParameters::getInstance();
+	nodes = vector<Node*>();
+	memory = vector<size_t>();
+}
+
+NodeQueue::~NodeQueue()
+{
+	for(unsigned int k=0; k < nodes.size(); k++){
+		delete nodes[k];
+	}
+	nodes.clear();
+	memory.clear();
+}
+
+void NodeQueue::push(Node *node)
+{
+	size_t bytes = node->getMemoryEstimate();
+
+	nodes.push_back(node);
+	memory.push_back(bytes);
+	totalMemory += bytes;
+	lastPushed++;
+}
+
+Node *NodeQueue::pop()
+{
+	int k;
+
+	//Depth first while the open nodes exceed the limits
+	bool exceeded = isMemoryExceeded();
+	if(exceeded != dfsMode){
+		dfsMode = exceeded;
+		cout << "Open nodes: " << nodes.size() << " (" << getMemoryUsage() << " MB). " 
+			<< (dfsMode? "Switching to depth first search." : "Back to the configured node selection.") << endl;
+	}
+
+	if(selection == NODE_DFS || dfsMode){
+		k = nodes.size() - 1;
+	}else if(plungeDepth > 0 && lastPushed > 0){
+		//Plunge into the last child pushed
+		k = nodes.size() - 1;
+		plungeDepth--;
+	}else{
+		k = select();
+		plungeDepth = 0;
+
+		selections++;
+		if(parameters->getPlungingFrequency() > 0 && selections % parameters->getPlungingFrequency() == 0){
+			plungeDepth = parameters->getMaxPlungeDepth();
+		}
+	}
+
+	Node *node = nodes[k];
+	remove(k);
+	lastPushed = 0;
+
+	return node;
+}
+
+Node *NodeQueue::steal()
+{
+	//Other workers take the oldest node (depth first) or the best one, never the current plunge
+	int k = (selection == NODE_DFS)? 0 : select();
+
+	Node *node = nodes[k];
+	remove(k);
+	if(k == (int)nodes.size()) lastPushed = 0;
+
+	return node;
+}
+
+int NodeQueue::select()
+{
+	int best = 0;
+	double bestValue = 1e13;
+
+	for(unsigned int k=0; k < nodes.size(); k++){
+		double value = (selection == NODE_BEST_ESTIMATE)? nodes[k]->getEstimate() : nodes[k]->getParentZLP();
+		if(value < bestValue){
+			bestValue = value;
+			best = k;
+		}
+	}
+
+	return best;
+}
+
+void NodeQueue::remove(int k)
+{
+	totalMemory -= memory[k];
+	nodes.erase(nodes.begin() + k);
+	memory.erase(memory.begin() + k);
+}
+
+int NodeQueue::pruneByBound(double ZInc)
+{
+	int pruned = 0;
+
+	for(int k = nodes.size() - 1; k >= 0; k--){
+		if(nodes[k]->getParentZLP() >= ZInc - parameters->getEpsilon()){
+			delete nodes[k];
+			remove(k);
+			pruned++;
+		}
+	}
+
+	return pruned;
+}
+
+int NodeQueue::offload(NodeStore *store, double maxMemory)
+{
+	int stored = 0;
+
+	while(getMemoryUsage() > maxMemory){
+		//Node in memory that would be selected last (the children just pushed are kept)
+		int worst = -1;
+		double worstValue = -1e13;
+		for(int k=0; k < (int)nodes.size() - 2; k++){
+			if(nodes[k]->isStored()) continue;
+
+			double value;
+			if(selection == NODE_DFS) value = -k;
+			else if(selection == NODE_BEST_ESTIMATE) value = nodes[k]->getEstimate();
+			else value = nodes[k]->getParentZLP();
+
+			if(value > worstValue){
+				worstValue = value;
+				worst = k;
+			}
+		}
+		if(worst < 0) break;
+
+		store->save(nodes[worst]);
+		totalMemory -= memory[worst];
+		memory[worst] = nodes[worst]->getMemoryEstimate();
+		totalMemory += memory[worst];
+		stored++;
+	}
+
+	return stored;
+}
+
+double NodeQueue::getBound()
+{
+	double bound = 1e13;
+
+	for(unsigned int k=0; k < nodes.size(); k++){
+		bound = min(bound, nodes[k]->getParentZLP());
+	}
+
+	return bound;
+}
+
+bool NodeQueue::isMemoryExceeded()
+{
+	return ((int)nodes.size() > parameters->getMaxOpenNodes() || getMemoryUsage() > parameters->getMaxOpenNodesMemory());
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Node.h"
+#include "GlobalParameters.h"
+#include "NodeStore.h"
+
+#include <vector>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+//Node selection strategies
+enum NodeSelection
+{
+	NODE_DFS = 0,
+	NODE_BEST_FIRST,
+	NODE_BEST_ESTIMATE
+};
+
+/**
+* Open nodes of the branch and price tree.
+* Nodes are selected by bound (best first), by estimate (best estimate) or LIFO (depth first).
+* Every plungingFrequency selections the search plunges into the children of the selected node,
+* and it falls back to depth first while the open nodes exceed the configured number or memory.
+*/
+class NodeQueue
+{
+public:
+	NodeQueue(NodeSelection s);
+	~NodeQueue();
+
+	void push(Node *node);
+	Node *pop();
+	Node *steal();
+	int pruneByBound(double ZInc);
+	int offload(NodeStore *store, double maxMemory);
+
+	//GET METHODS
+	int size(){ return nodes.size(); }
+	Node *getNode(int k){ return nodes[k]; }
+	bool isEmpty(){ return nodes.size() == 0; }
+	double getBound();
+	double getMemoryUsage(){ return totalMemory / (1024.0 * 1024.0); }
+	bool isMemoryExceeded();
+
+private:
+	GlobalParameters *parameters;
+	NodeSelection selection;
+
+	vector<Node*> nodes;
+	vector<size_t> memory;
+	size_t totalMemory;
+
+	int selections;
+	int plungeDepth;	//nodes left in the current plunge
+	int lastPushed;		//children pushed since the last selection
+	bool dfsMode;
+
+	int select();
+	void remove(int k);
+};
@@ -0,0 +1,425 @@
+#include "NodeStore.h"
+
+#include <cstdio>
+#include <sstream>
+
+NodeStore::NodeStore(GRBModel *master, const VariableHash &v, const ConstraintHash &c, int numWorkers) : vHash(v), cHash(c), cutPool(nullptr), fileSize(0), liveSize(0), storedNodes(0)
+{
+	parameters = GlobalParameters::getInstance();
+
+	masterFile = "master.mps";
+	master->write(masterFile);
+	masters = vector<GRBModel*>(numWorkers, nullptr);
+	snapshots = vector<string>(numWorkers);
+	routes = vector<Route*>();
+
+	storeFile = "open_nodes.bin";
+	file.open(storeFile.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+	omp_init_lock(&lock);
+}
+
+NodeStore::~NodeStore()
+{
+	for(unsigned int w=0; w < masters.size(); w++){
+		delete masters[w];
+	}
+	for(unsigned int i=0; i < routes.size(); i++){
+		delete routes[i];
+	}
+	routes.clear();
+	vHash.clear();
+	cHash.clear();
+
+	file.close();
+	remove(storeFile.c_str());
+	remove(masterFile.c_str());
+	omp_destroy_lock(&lock);
+}
+
+void NodeStore::acquireRoute(Route *route)
+{
+	int routeNumber = route->getRouteNumber();
+
+	omp_set_lock(&lock);
+	if(routeNumber >= (int)routes.size()){
+		routes.resize(routeNumber + 1, nullptr);
+		references.resize(routeNumber + 1, 0);
+	}
+	if(routes[routeNumber] == nullptr) routes[routeNumber] = route->clone();
+	references[routeNumber]++;
+	omp_unset_lock(&lock);
+}
+
+void NodeStore::acquireRoutes(const vector<int> &routeNumbers)
+{
+	omp_set_lock(&lock);
+	for(unsigned int i=0; i < routeNumbers.size(); i++){
+		if(routeNumbers[i] < (int)routes.size() && routes[routeNumbers[i]] != nullptr) references[routeNumbers[i]]++;
+	}
+	omp_unset_lock(&lock);
+}
+
+void NodeStore::releaseRoutes(const vector<int> &routeNumbers)
+{
+	omp_set_lock(&lock);
+	for(unsigned int i=0; i < routeNumbers.size(); i++){
+		int r = routeNumbers[i];
+		if(r >= (int)routes.size() || routes[r] == nullptr) continue;
+		if(--references[r] == 0){
+			delete routes[r];
+			routes[r] = nullptr;
+		}
+	}
+	omp_unset_lock(&lock);
+}
+
+void NodeStore::save(Node *node)
+{
+	vector<int> columns = node->getColumnNumbers();
+	vector<int> cuts = getCutRecord(node);
+	vector<pair<Variable,double>> &decisions = node->getDecisions();
+
+	omp_set_lock(&lock);
+	long long offset = fileSize;
+	file.seekp(offset);
+	writeRecord(file, decisions, columns, cuts, node->getVBasis(), node->getCBasis());
+	fileSize = file.tellp();
+	int record = newRecord(offset);
+	omp_unset_lock(&lock);
+
+	node->setStoreRecord(record);
+	node->release();
+}
+
+void NodeStore::load(Node *node, GRBEnv *env, int worker)
+{
+	vector<pair<Variable,double>> decisions;
+	vector<int> routeNumbers, cuts, vb, cb;
+	vector<Route*> columns;
+
+	omp_set_lock(&lock);
+	file.seekg(recordOffsets[node->getStoreRecord()]);
+	readRecord(file, decisions, routeNumbers, cuts, vb, cb);
+	for(unsigned int i=0; i < routeNumbers.size(); i++){
+		if(routeNumbers[i] < (int)routes.size() && routes[routeNumbers[i]] != nullptr)
+			columns.push_back(routes[routeNumbers[i]]);
+	}
+	freeRecord(node->getStoreRecord());
+	omp_unset_lock(&lock);
+	node->setStoreRecord(-1);
+
+	if(masters[worker] == nullptr){
+		masters[worker] = new GRBModel(*env, masterFile);
+	}
+
+	//Same columns in the same order, then the same branching rows and cuts interleaved as they were added,
+	//so the saved basis still fits. The node holds its routes until the columns are added again
+	vector<int> held;
+	held.swap(node->getColumns());
+	node->restore(masters[worker], vHash, cHash);
+	for(unsigned int i=0; i < columns.size(); i++){
+		node->addColumn(columns[i]);
+	}
+	releaseRoutes(held);
+	unsigned int k = 0;
+	for(unsigned int i=0; i <= decisions.size(); i++){
+		for(; k < cuts.size() && cuts[k+1] <= (int)i; k += 2){
+			node->addCut(cutPool->getCut(cuts[k]));
+		}
+		if(i < decisions.size()) node->addBranchConstraint(decisions[i].first, decisions[i].second);
+	}
+	node->setWarmStart(vb, cb);
+}
+
+void NodeStore::drop(Node *node)
+{
+	//A stored node pruned without being rebuilt
+	omp_set_lock(&lock);
+	freeRecord(node->getStoreRecord());
+	omp_unset_lock(&lock);
+	node->setStoreRecord(-1);
+}
+
+int NodeStore::newRecord(long long offset)
+{
+	int record;
+	if(freeRecords.size() > 0){
+		record = freeRecords.back();
+		freeRecords.pop_back();
+	}else{
+		record = recordOffsets.size();
+		recordOffsets.push_back(-1);
+		recordSizes.push_back(0);
+	}
+
+	recordOffsets[record] = offset;
+	recordSizes[record] = fileSize - offset;
+	liveSize += recordSizes[record];
+	storedNodes++;
+
+	//Most of the file belongs to records already freed
+	if(fileSize > 2 * liveSize + (1 << 20)) compact();
+	return record;
+}
+
+void NodeStore::freeRecord(int record)
+{
+	liveSize -= recordSizes[record];
+	recordOffsets[record] = -1;
+	recordSizes[record] = 0;
+	freeRecords.push_back(record);
+	storedNodes--;
+}
+
+void NodeStore::compact()
+{
+	//Live records are copied to a new file, the nodes keep their record numbers
+	string tempFile = storeFile + ".tmp";
+	fstream out(tempFile.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+	vector<char> buffer;
+	long long offset = 0;
+
+	for(unsigned int r=0; r < recordOffsets.size(); r++){
+		if(recordOffsets[r] < 0) continue;
+
+		buffer.resize((size_t)recordSizes[r]);
+		file.seekg(recordOffsets[r]);
+		file.read(&buffer[0], recordSizes[r]);
+		out.write(&buffer[0], recordSizes[r]);
+		recordOffsets[r] = offset;
+		offset += recordSizes[r];
+	}
+
+	out.close();
+	file.close();
+	remove(storeFile.c_str());
+	rename(tempFile.c_str(), storeFile.c_str());
+	file.open(storeFile.c_str(), ios::in | ios::out | ios::binary);
+	fileSize = offset;
+}
+
+void NodeStore::writeNode(ostream &out, Node *node)
+{
+	vector<pair<Variable,double>> decisions;
+	vector<int> columns, cuts, vb, cb;
+
+	//Bounds and branching that created the node
+	int ids[2] = {node->getNodeId(), node->getDepth()};
+	double values[3] = {node->getParentZLP(), node->getEstimate(), node->getBranchRhs()};
+	out.write((char*)ids, 2 * sizeof(int));
+	out.write((char*)values, 3 * sizeof(double));
+	writeVariable(out, node->getBranchVariable());
+
+	if(node->isStored()){
+		omp_set_lock(&lock);
+		file.seekg(recordOffsets[node->getStoreRecord()]);
+		readRecord(file, decisions, columns, cuts, vb, cb);
+		omp_unset_lock(&lock);
+
+		writeRecord(out, decisions, columns, cuts, vb, cb);
+	}else{
+		writeRecord(out, node->getDecisions(), node->getColumnNumbers(), getCutRecord(node), node->getVBasis(), node->getCBasis());
+	}
+}
+
+Node *NodeStore::readNode(istream &in, int cDual, int eDual)
+{
+	vector<pair<Variable,double>> decisions;
+	vector<int> columns, cuts, vb, cb;
+
+	int ids[2];
+	double values[3];
+	in.read((char*)ids, 2 * sizeof(int));
+	in.read((char*)values, 3 * sizeof(double));
+	Variable branchVariable = readVariable(in);
+	readRecord(in, decisions, columns, cuts, vb, cb);
+
+	//The node starts stored, it is rebuilt when selected
+	Node *node = new Node(cDual, eDual);
+	node->setNodeId(ids[0]);
+	node->setDepth(ids[1]);
+	node->setBranch(branchVariable, values[2], values[0]);
+	node->setEstimate(values[1]);
+	node->release();
+	node->getColumns() = columns;
+	acquireRoutes(columns);
+
+	omp_set_lock(&lock);
+	long long offset = fileSize;
+	file.seekp(offset);
+	writeRecord(file, decisions, columns, cuts, vb, cb);
+	fileSize = file.tellp();
+	int record = newRecord(offset);
+	omp_unset_lock(&lock);
+
+	node->setStoreRecord(record);
+	return node;
+}
+
+void NodeStore::snapshot(int worker, Node *node)
+{
+	stringstream out;
+	writeNode(out, node);
+	snapshots[worker] = out.str();
+}
+
+int NodeStore::writeSnapshots(ostream &out)
+{
+	int count = 0;
+
+	for(unsigned int w=0; w < snapshots.size(); w++){
+		if(snapshots[w].size() == 0) continue;
+		out.write(snapshots[w].data(), snapshots[w].size());
+		count++;
+	}
+
+	return count;
+}
+
+void NodeStore::writeRoutes(ostream &out)
+{
+	omp_set_lock(&lock);
+
+	int numRoutes = 0;
+	for(unsigned int i=0; i < routes.size(); i++){
+		if(routes[i] != nullptr) numRoutes++;
+	}
+	out.write((char*)&numRoutes, sizeof(int));
+
+	for(unsigned int i=0; i < routes.size(); i++){
+		if(routes[i] == nullptr) continue;
+
+		int fields[3] = {routes[i]->getRouteNumber(), routes[i]->getEquipmentType(), (int)routes[i]->edges.size()};
+		double cost = routes[i]->getCost();
+		out.write((char*)fields, 3 * sizeof(int));
+		out.write((char*)&cost, sizeof(double));
+
+		vector<Edge*>::iterator eit = routes[i]->edges.begin();
+		for(; eit != routes[i]->edges.end(); eit++){
+			int edge[3] = {(*eit)->getStartJob(), (*eit)->getEndJob(), (*eit)->getTime()};
+			out.write((char*)edge, 3 * sizeof(int));
+		}
+	}
+
+	omp_unset_lock(&lock);
+}
+
+vector<int> NodeStore::readRoutes(istream &in)
+{
+	//Every route read holds a reference until the caller has read the nodes that use it
+	vector<int> routeNumbers;
+	int numRoutes;
+	in.read((char*)&numRoutes, sizeof(int));
+
+	for(int i=0; i < numRoutes; i++){
+		int fields[3];
+		double cost;
+		in.read((char*)fields, 3 * sizeof(int));
+		in.read((char*)&cost, sizeof(double));
+
+		Route *route = new Route(fields[1]);
+		route->setRouteNumber(fields[0]);
+		route->setCost(cost);
+		for(int k=0; k < fields[2]; k++){
+			int edge[3];
+			in.read((char*)edge, 3 * sizeof(int));
+			route->edges.push_back(new Edge(edge[0], edge[1], edge[2]));
+		}
+
+		acquireRoute(route);
+		routeNumbers.push_back(fields[0]);
+		delete route;
+	}
+
+	return routeNumbers;
+}
+
+void NodeStore::writeRecord(ostream &out, const vector<pair<Variable,double>> &decisions, const vector<int> &columns, const vector<int> &cuts, const vector<int> &vb, const vector<int> &cb)
+{
+	int numDecisions = decisions.size();
+	out.write((char*)&numDecisions, sizeof(int));
+	for(int i=0; i < numDecisions; i++){
+		writeVariable(out, decisions[i].first);
+		out.write((char*)&decisions[i].second, sizeof(double));
+	}
+
+	writeVector(out, columns);
+	writeVector(out, cuts);
+	writeVector(out, vb);
+	writeVector(out, cb);
+}
+
+void NodeStore::readRecord(istream &in, vector<pair<Variable,double>> &decisions, vector<int> &columns, vector<int> &cuts, vector<int> &vb, vector<int> &cb)
+{
+	int numDecisions;
+	in.read((char*)&numDecisions, sizeof(int));
+	for(int i=0; i < numDecisions; i++){
+		Variable v = readVariable(in);
+		double rhs;
+		in.read((char*)&rhs, sizeof(double));
+		decisions.push_back(make_pair(v, rhs));
+	}
+
+	columns = readVector(in);
+	cuts = readVector(in);
+	vb = readVector(in);
+	cb = readVector(in);
+}
+
+vector<int> NodeStore::getCutRecord(Node *node)
+{
+	//Pairs (cut id, position among the branching decisions)
+	vector<int> record;
+	vector<ActiveCut> &cuts = node->getCuts();
+	for(unsigned int k=0; k < cuts.size(); k++){
+		record.push_back(cuts[k].id);
+		record.push_back(cuts[k].position);
+	}
+	return record;
+}
+
+void NodeStore::writeVariable(ostream &out, const Variable &v)
+{
+	int fields[7] = {v.getType(), v.getStartJob(), v.getEndJob(), v.getTime(), v.getArrivalTime(), v.getEquipmentType(), v.getRouteNumber()};
+	double value = v.getValue();
+
+	out.write((char*)fields, 7 * sizeof(int));
+	out.write((char*)&value, sizeof(double));
+}
+
+Variable NodeStore::readVariable(istream &in)
+{
+	int fields[7];
+	double value;
+
+	in.read((char*)fields, 7 * sizeof(int));
+	in.read((char*)&value, sizeof(double));
+
+	Variable v;
+	v.setType((VariableType)fields[0]);
+	v.setStartJob(fields[1]);
+	v.setEndJob(fields[2]);
+	v.setTime(fields[3]);
+	v.setArrivalTime(fields[4]);
+	v.setEquipmentTipe(fields[5]);
+	v.setRouteNumber(fields[6]);
+	v.setValue(value);
+	return v;
+}
+
+void NodeStore::writeVector(ostream &out, const vector<int> &values)
+{
+	int size = values.size();
+	out.write((char*)&size, sizeof(int));
+	if(size > 0) out.write((char*)&values[0], size * sizeof(int));
+}
+
+vector<int> NodeStore::readVector(istream &in)
+{
+	int size;
+	in.read((char*)&size, sizeof(int));
+
+	vector<int> values = vector<int>(size);
+	if(size > 0) in.read((char*)&values[0], size * sizeof(int));
+	return values;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "gurobi_c++.h"
+#include "Node.h"
+#include "Route.h"
+#include "CutPool.h"
+#include "Variable.h"
+#include "Constraint.h"
+#include "GlobalParameters.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <omp.h>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+/**
+* Out of core storage of open nodes.
+* A stored node only keeps its bounds and column numbers in memory. Its branching decisions, the numbers of its
+* columns, its cuts and its warm start basis are appended to a file as a record, and every route is kept once
+* here while a node (stored or not) has it as a column. When selected, the node is rebuilt from the master
+* without columns. The file is compacted when most of it belongs to nodes already popped or pruned.
+*/
+class NodeStore
+{
+public:
+	NodeStore(GRBModel *master, const VariableHash &v, const ConstraintHash &c, int numWorkers);
+	~NodeStore();
+
+	void acquireRoute(Route *route);
+	void acquireRoutes(const vector<int> &routeNumbers);
+	void releaseRoutes(const vector<int> &routeNumbers);
+	void setCutPool(CutPool *pool){ cutPool = pool; }
+	void save(Node *node);
+	void load(Node *node, GRBEnv *env, int worker);
+	void drop(Node *node);
+
+	//Checkpoints: routes and open nodes, including the ones being evaluated by each worker
+	void writeNode(ostream &out, Node *node);
+	Node *readNode(istream &in, int cDual, int eDual);
+	void snapshot(int worker, Node *node);
+	void clearSnapshot(int worker){ snapshots[worker].clear(); }
+	int writeSnapshots(ostream &out);
+	void writeRoutes(ostream &out);
+	vector<int> readRoutes(istream &in);
+
+	//GET METHODS
+	int getStoredNodes(){ return storedNodes; }
+	double getFileSize(){ return fileSize / (1024.0 * 1024.0); }
+
+private:
+	GlobalParameters *parameters;
+
+	//Master without columns, read once in the enviroment of each worker
+	string masterFile;
+	vector<GRBModel*> masters;
+	VariableHash vHash;
+	ConstraintHash cHash;
+
+	//Routes by route number and the number of nodes that have each one as a column
+	vector<Route*> routes;
+	vector<int> references;
+	CutPool *cutPool;
+
+	//Offset and size of every record (-1 = free), stored nodes refer to their record
+	string storeFile;
+	fstream file;
+	long long fileSize;
+	long long liveSize;
+	vector<long long> recordOffsets;
+	vector<long long> recordSizes;
+	vector<int> freeRecords;
+	int storedNodes;
+	omp_lock_t lock;
+
+	//Node being evaluated by each worker (written with writeNode)
+	vector<string> snapshots;
+
+	int newRecord(long long offset);
+	void freeRecord(int record);
+	void compact();
+	void writeRecord(ostream &out, const vector<pair<Variable,double>> &decisions, const vector<int> &columns, const vector<int> &cuts, const vector<int> &vb, const vector<int> &cb);
+	void readRecord(istream &in, vector<pair<Variable,double>> &decisions, vector<int> &columns, vector<int> &cuts, vector<int> &vb, vector<int> &cb);
+	vector<int> getCutRecord(Node *node);
+	void writeVariable(ostream &out, const Variable &v);
+	Variable readVariable(istream &in);
+	void writeVector(ostream &out, const vector<int> &values);
+	vector<int> readVector(istream &in);
+};
@@ -0,0 +1,95 @@
+#include "PseudoCost.h"
+
+#include <cmath>
+#include <algorithm>
+
+PseudoCostStore::PseudoCostStore()
+{
+	parameters = GlobalParameters::getInstance();
+	costs = PseudoCostHash();
+}
+
+PseudoCostStore::~PseudoCostStore()
+{
+	costs.clear();
+}
+
+Variable PseudoCostStore::getKey(const Variable &v)
+{
+	Variable key;
+	key.setType(v.getType());
+	key.setStartJob(v.getStartJob());
+	key.setEndJob(v.getEndJob());
+	key.setEquipmentTipe(v.getEquipmentType());
+	return key;
+}
+
+void PseudoCostStore::update(const Variable &v, double rhs, double deltaZ)
+{
+	double f = v.getValue() - floor(v.getValue());
+	if(f < parameters->getEpsilon() || f > 1 - parameters->getEpsilon()) return;
+
+	deltaZ = max(deltaZ, 0.0);
+
+	//Shared by the workers of the parallel tree search
+	#pragma omp critical(pseudoCosts)
+	{
+		PseudoCost &pc = costs[getKey(v)];
+		if(rhs < 0.5){
+			pc.addDown(deltaZ / f);
+			average.addDown(deltaZ / f);
+		}else{
+			pc.addUp(deltaZ / (1 - f));
+			average.addUp(deltaZ / (1 - f));
+		}
+	}
+}
+
+bool PseudoCostStore::isReliable(const Variable &v, int threshold)
+{
+	bool reliable = false;
+
+	#pragma omp critical(pseudoCosts)
+	{
+		PseudoCostHash::iterator it = costs.find(getKey(v));
+		if(it != costs.end()){
+			reliable = (min(it->second.getDownCount(), it->second.getUpCount()) >= threshold);
+		}
+	}
+
+	return reliable;
+}
+
+double PseudoCostStore::getScore(const Variable &v)
+{
+	double down, up;
+	getGains(v, down, up);
+	return getScore(down, up);
+}
+
+void PseudoCostStore::getGains(const Variable &v, double &downGain, double &upGain)
+{
+	double f = v.getValue() - floor(v.getValue());
+	double down, up;
+
+	#pragma omp critical(pseudoCosts)
+	{
+		down = (average.getDownCount() > 0)? average.getDown() : 1.0;
+		up = (average.getUpCount() > 0)? average.getUp() : 1.0;
+
+		PseudoCostHash::iterator it = costs.find(getKey(v));
+		if(it != costs.end()){
+			if(it->second.getDownCount() > 0) down = it->second.getDown();
+			if(it->second.getUpCount() > 0) up = it->second.getUp();
+		}
+	}
+
+	downGain = f * down;
+	upGain = (1 - f) * up;
+}
+
+double PseudoCostStore::getScore(double downGain, double upGain)
+{
+	double epsilon = 1e-6;
+	return max(downGain, epsilon) * max(upGain, epsilon);
+}
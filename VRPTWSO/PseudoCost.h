@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Variable.h"
+#include "GlobalParameters.h"
+
+#include <hash_map>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+/**
+* Bound change per unit of fractionality observed when branching down (rhs 0) and up (rhs 1).
+*/
+class PseudoCost
+{
+public:
+	PseudoCost() : downSum(0.0), upSum(0.0), downCount(0), upCount(0) {}
+
+	//GET METHODS
+	double getDown() const { return downSum / downCount; }
+	double getUp() const { return upSum / upCount; }
+	int getDownCount() const { return downCount; }
+	int getUpCount() const { return upCount; }
+
+	void addDown(double gain){ downSum += gain; downCount++; }
+	void addUp(double gain){ upSum += gain; upCount++; }
+
+private:
+	double downSum, upSum;
+	int downCount, upCount;
+};
+
+typedef stdext::hash_map<Variable, PseudoCost, VariableHasher> PseudoCostHash;
+
+/**
+* Pseudo costs of the branching variables, aggregated over time by (type, sJob, eJob, eqType).
+*/
+class PseudoCostStore
+{
+public:
+	PseudoCostStore();
+	~PseudoCostStore();
+
+	void update(const Variable &v, double rhs, double deltaZ);
+	bool isReliable(const Variable &v, int threshold);
+	double getScore(const Variable &v);
+	void getGains(const Variable &v, double &downGain, double &upGain);
+
+	static double getScore(double downGain, double upGain);
+
+private:
+	GlobalParameters *parameters;
+	PseudoCostHash costs;
+
+	//Average over all variables, used for the ones never branched on
+	PseudoCost average;
+
+	Variable getKey(const Variable &v);
+};
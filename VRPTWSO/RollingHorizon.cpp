@@ -0,0 +1,302 @@
+#include "RollingHorizon.h"
+#include "Solver.h"
+
+#include <time.h>
+#include <algorithm>
+
+RollingHorizon::RollingHorizon(ProblemData *d) : data(d), solutionValue(0.0), solution(nullptr)
+{
+	parameters = GlobalParameters::getInstance();
+	committed = vector<bool>(data->numJobs, false);
+	startTime = vector<int>(data->numJobs, -1);
+	machineStates = vector<vector<pair<int,int>>>(data->numEquipments);
+	machineLoads = vector<vector<int>>(data->numEquipments);
+}
+
+RollingHorizon::~RollingHorizon()
+{
+	delete solution;
+}
+
+int RollingHorizon::solve()
+{
+	int windowLength = parameters->getRollingWindowLength();
+	int commitLength = max(1, min(parameters->getRollingCommitLength(), windowLength));
+	if(data->getNumNetworkShifts() > 1){
+		//Machines are only back at the depot at the end of a shift
+		commitLength = ((commitLength + data->workShiftLength - 1) / data->workShiftLength) * data->workShiftLength;
+		windowLength = max(windowLength, commitLength);
+	}
+
+	clock_t start = clock();
+	int result = GRB_OPTIMAL, windows = 0;
+	for(int windowStart = 0; ; windowStart += commitLength){
+		int windowEnd = windowStart + windowLength;
+		bool last = (windowEnd >= data->horizonLength);
+		ProblemData *window = buildWindow(windowEnd, last);
+
+		int numJobs = count(machineCopies.begin() + 1, machineCopies.end(), -1);
+		if(numJobs == 0){
+			//Nothing new to schedule, at the end the machines carried over go back to the depot
+			if(last){
+				for(int eqType=0; eqType < data->numEquipments; eqType++){
+					for(unsigned int m=0; m < machineStates[eqType].size(); m++){
+						addEdge(machineStates[eqType][m].first, 0, machineStates[eqType][m].second, data->horizonLength, eqType);
+					}
+				}
+			}
+			deleteWindow(window);
+			if(last) break;
+			continue;
+		}
+
+		windows++;
+		cout << "Rolling horizon window " << windows << " [" << windowStart << "," << min(windowEnd, data->horizonLength) << "]: ";
+		cout << numJobs << " jobs, " << window->numJobs - numJobs - 1 << " machines carried over" << endl;
+
+		vector<int> windowEdges;
+		parameters->setNumJobs(window->numJobs);
+		result = solveWindow(window, windowEdges);
+		parameters->setNumJobs(data->numJobs);
+
+		if(windowEdges.size() == 0){
+			cout << "Rolling horizon: window " << windows << " has no feasible solution." << endl;
+			deleteWindow(window);
+			return GRB_INFEASIBLE;
+		}
+
+		commitWindow(window, windowEdges, windowStart + commitLength, last);
+		deleteWindow(window);
+		if(last) break;
+	}
+
+	solution = new Solution();
+	for(unsigned int k=0; k + 4 < edges.size(); k += 5){
+		solution->addEdge(edges[k], edges[k+1], edges[k+2], edges[k+3], edges[k+4]);
+	}
+	solution->setSolutionValue(solutionValue);
+
+	cout << "Rolling horizon: " << windows << " windows of " << windowLength << " periods committed every " << commitLength;
+	cout << " - Solution value: " << solutionValue << " - Total time: " << (double)(clock() - start)/CLOCKS_PER_SEC << "s" << endl;
+	cout << solution->toString();
+
+	return result;
+}
+
+ProblemData *RollingHorizon::buildWindow(int windowEnd, bool last)
+{
+	//Depot, jobs not frozen that may start before the end of the window and a copy of the last job of every machine in use
+	windowJobs = vector<int>(1, 0);
+	machineCopies = vector<int>(1, -1);
+	vector<int> demands(1, 0);
+	for(int j=1; j < data->numJobs; j++){
+		if(!committed[j] && (last || data->jobs[j]->getFirstStartTimePeriod() < windowEnd)){
+			windowJobs.push_back(j);
+			machineCopies.push_back(-1);
+			demands.push_back(data->jobs[j]->getDemand());
+		}
+	}
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(unsigned int m=0; m < machineStates[eqType].size(); m++){
+			windowJobs.push_back(machineStates[eqType][m].first);
+			machineCopies.push_back(eqType);
+			demands.push_back(machineLoads[eqType][m]);
+		}
+	}
+	int n = windowJobs.size();
+
+	ProblemData *window = new ProblemData();
+	window->numJobs = n;
+	window->numEquipments = data->numEquipments;
+	window->numLocations = data->numLocations;
+	window->horizonLength = data->horizonLength;
+	window->numWorkShifts = data->numWorkShifts;
+	window->workShiftLength = data->workShiftLength;
+	window->parameters = parameters;
+
+	//Every machine in use is kept, the others only if the window has jobs for them (all machines must be used).
+	//A copy is only reached from the depot: from any other job it would be reached after the horizon
+	window->equipments = vector<Equipment*>(data->numEquipments);
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		Equipment *e = data->equipments[eqType];
+		int inUse = machineStates[eqType].size(), jobs = 0;
+		for(int i=1; i < n; i++){
+			if(machineCopies[i] < 0 && data->jobs[windowJobs[i]]->getEquipmentTypeRequired(eqType) > 0) jobs++;
+		}
+		window->equipments[eqType] = new Equipment(eqType, inUse + min(e->getNumMachines() - inUse, jobs), (int)e->getMaxTransitionTime(), e->getCapacity());
+
+		vector<vector<double>> transitionTimes(n + 1, vector<double>(n + 1, 0));
+		for(int i=0; i < n; i++){
+			for(int j=0; j < n; j++){
+				if(i != 0 && i != j && machineCopies[j] >= 0)
+					transitionTimes[i][j] = 2 * data->horizonLength;
+				else
+					transitionTimes[i][j] = e->getNotRoundedTransitionTime(windowJobs[i], windowJobs[j]);
+			}
+		}
+		window->equipments[eqType]->setTransitionTimes(transitionTimes);
+	}
+
+	//Jobs keep their start times, a copy is fixed at the start time of the job it stands for and carries the load of its machine
+	int shiftLength = (parameters->useShiftDecomposition())? data->workShiftLength : data->horizonLength;
+	window->jobs = vector<Job*>(n);
+	for(int i=0; i < n; i++){
+		Job *job = data->jobs[windowJobs[i]];
+		window->jobs[i] = new Job(i, job->getWeight(), job->getServiceTime(), job->getLocationId(), demands[i]);
+
+		vector<bool> workShifts(data->numWorkShifts);
+		vector<int> readyDates(data->numWorkShifts), dueDates(data->numWorkShifts);
+		for(int s=0; s < data->numWorkShifts; s++){
+			workShifts[s] = job->getWorkShift(s);
+			readyDates[s] = job->getReleaseDate(s);
+			dueDates[s] = job->getDueDate(s);
+		}
+		vector<int> equipmentTypes(data->numEquipments);
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			equipmentTypes[eqType] = (machineCopies[i] < 0)? job->getEquipmentTypeRequired(eqType) : (eqType == machineCopies[i])? 1 : 0;
+		}
+
+		window->jobs[i]->setEquipmentTypes(equipmentTypes);
+		window->jobs[i]->setWorkShifts(workShifts);
+		window->jobs[i]->setReadyDates(readyDates);
+		window->jobs[i]->setDueDates(dueDates);
+		window->jobs[i]->setTimePeriods(data->horizonLength, shiftLength, window->equipments);
+		if(machineCopies[i] >= 0)
+			window->jobs[i]->tightenStartTimes(startTime[windowJobs[i]], startTime[windowJobs[i]]);
+		else if(i > 0)
+			window->jobs[i]->tightenStartTimes(job->getFirstStartTimePeriod(), job->getLastStartTimePeriod());
+	}
+
+	//Precedences between window jobs are kept, the ones with frozen jobs bound the start times
+	vector<int> windowIndex(data->numJobs, -1);
+	for(int i=1; i < n; i++){
+		if(machineCopies[i] < 0) windowIndex[windowJobs[i]] = i;
+	}
+	window->successors = vector<vector<pair<int,int>>>(n);
+	window->predecessors = vector<vector<pair<int,int>>>(n);
+	for(int i=1; i < n; i++){
+		if(machineCopies[i] >= 0) continue;
+		int j = windowJobs[i];
+
+		for(unsigned int p=0; p < data->successors[j].size(); p++){
+			int k = data->successors[j][p].first, delta = data->successors[j][p].second;
+			if(windowIndex[k] > 0){
+				window->successors[i].push_back(make_pair(windowIndex[k], delta));
+				window->predecessors[windowIndex[k]].push_back(make_pair(i, delta));
+				window->numPrecedences++;
+			}else if(committed[k]){
+				window->jobs[i]->tightenStartTimes(0, startTime[k] - delta);
+			}
+		}
+		for(unsigned int p=0; p < data->predecessors[j].size(); p++){
+			int k = data->predecessors[j][p].first;
+			if(committed[k]) window->jobs[i]->tightenStartTimes(startTime[k] + data->predecessors[j][p].second, data->horizonLength);
+		}
+	}
+	window->tightenTimeWindows();
+
+	window->problemNetwork = VertexIndex(n);
+	window->vertexSet = set<Vertex*,VertexComparator>();
+	return window;
+}
+
+int RollingHorizon::solveWindow(ProblemData *window, vector<int> &windowEdges)
+{
+	//Same as the whole horizon (see main): solved again while the dynamic discretization adds time points
+	if(parameters->useDynamicDiscretization()) window->initTimePoints();
+
+	int result;
+	while(true){
+		Solver *mySolver = new Solver(window);
+		result = mySolver->solve();
+		Solution *best = mySolver->getBestSolution();
+		int added = window->refineTimePoints(best);
+		if(added == 0 && best != nullptr) windowEdges = best->getEdges();
+		delete mySolver;
+
+		if(added == 0) break;
+		window->clearNetwork();
+	}
+
+	return result;
+}
+
+void RollingHorizon::commitWindow(ProblemData *window, const vector<int> &windowEdges, int commitEnd, bool last)
+{
+	int n = window->numJobs;
+	bool shifts = (window->getNumNetworkShifts() > 1);
+
+	//Start time period of every job and its successor on each equipment type
+	vector<int> start(n, -1);
+	vector<vector<int>> next(data->numEquipments, vector<int>(n, 0));
+	for(unsigned int k=0; k + 4 < windowEdges.size(); k += 5){
+		int sJob = windowEdges[k], dJob = windowEdges[k+1];
+		if(sJob == dJob || sJob == 0) continue;
+		start[sJob] = windowEdges[k+2];
+		next[windowEdges[k+4]][sJob] = dJob;
+	}
+
+	//Jobs starting before the commit time are frozen (every job in the last window)
+	vector<bool> frozen(n, false);
+	for(int i=1; i < n; i++){
+		frozen[i] = (machineCopies[i] < 0 && start[i] >= 0 && (last || start[i] < commitEnd));
+	}
+
+	//Edges into frozen jobs are frozen, the ones back to the depot only when the route is over
+	for(unsigned int k=0; k + 4 < windowEdges.size(); k += 5){
+		int sJob = windowEdges[k], dJob = windowEdges[k+1];
+		if(sJob == dJob) continue;
+
+		bool freeze = (dJob == 0)? (last || (shifts && frozen[sJob])) : frozen[dJob];
+		if(freeze) addEdge(windowJobs[sJob], windowJobs[dJob], windowEdges[k+2], windowEdges[k+3], windowEdges[k+4]);
+	}
+
+	for(int i=1; i < n; i++){
+		if(!frozen[i]) continue;
+		committed[windowJobs[i]] = true;
+		startTime[windowJobs[i]] = start[i];
+	}
+
+	//Every route that has frozen jobs (or started at a copy) leaves its machine at its last frozen job.
+	//With the work shift decomposition all machines are back at the depot at the commit time
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		machineStates[eqType].clear();
+		machineLoads[eqType].clear();
+		if(last || shifts) continue;
+
+		for(unsigned int k=0; k + 4 < windowEdges.size(); k += 5){
+			if(windowEdges[k] != 0 || windowEdges[k+1] == 0 || windowEdges[k+4] != eqType) continue;
+
+			int job = windowEdges[k+1], lastJob = -1, lastTime = 0, load = 0;
+			while(job != 0 && (machineCopies[job] >= 0 || frozen[job])){
+				lastJob = windowJobs[job];
+				lastTime = start[job];
+				load += window->jobs[job]->getDemand();
+				job = next[eqType][job];
+			}
+			if(lastJob > 0){
+				machineStates[eqType].push_back(make_pair(lastJob, lastTime));
+				machineLoads[eqType].push_back(load);
+			}
+		}
+	}
+}
+
+void RollingHorizon::deleteWindow(ProblemData *window)
+{
+	window->clearNetwork();
+	for(unsigned int i=0; i < window->jobs.size(); i++){
+		delete window->jobs[i];
+	}
+	for(unsigned int e=0; e < window->equipments.size(); e++){
+		delete window->equipments[e];
+	}
+	delete window;
+}
+
+void RollingHorizon::addEdge(int sJob, int dJob, int sTime, int dTime, int eqType)
+{
+	int edge[5] = {sJob, dJob, sTime, dTime, eqType};
+	edges.insert(edges.end(), edge, edge + 5);
+	if(sJob != dJob) solutionValue += data->equipments[eqType]->getNotRoundedTransitionTime(sJob, dJob);
+}
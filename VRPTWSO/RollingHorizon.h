@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Data.h"
+#include "Solution.h"
+#include "GlobalParameters.h"
+
+#include <vector>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+/**
+* Rolling horizon driver for long planning horizons.
+* The horizon is covered by overlapping windows solved one after another by the Solver. A window holds the
+* jobs not yet frozen that may start before its end; the routes of its solution are frozen up to the commit
+* time (the start of the next window). Every machine that served a frozen job is carried over to the next
+* window as a copy of its last frozen job fixed at its start time, reachable only from the depot, so it
+* continues from that position and time. With the work shift decomposition windows are committed at shift
+* ends, where every machine is back at the depot.
+*/
+class RollingHorizon
+{
+public:
+	RollingHorizon(ProblemData *d);
+	~RollingHorizon();
+
+	int solve();
+
+	//GET METHODS
+	double getSolutionValue(){ return solutionValue; }
+	Solution *getSolution(){ return solution; }
+
+private:
+	ProblemData *data;
+	GlobalParameters *parameters;
+
+	//Frozen jobs and their start time periods
+	vector<bool> committed;
+	vector<int> startTime;
+	//Position (job) and start time of the last frozen job of every machine in use, per equipment type
+	vector<vector<pair<int,int>>> machineStates;
+	//Demand already served by every machine in use (load resource)
+	vector<vector<int>> machineLoads;
+	//Frozen edges (sJob, dJob, sTime, dTime, eqType) and their cost
+	vector<int> edges;
+	double solutionValue;
+	Solution *solution;
+
+	//Current window: original job of every window job, and the equipment type of the machine a copy stands for (-1 = real job)
+	vector<int> windowJobs;
+	vector<int> machineCopies;
+
+	ProblemData *buildWindow(int windowEnd, bool last);
+	int solveWindow(ProblemData *window, vector<int> &windowEdges);
+	void commitWindow(ProblemData *window, const vector<int> &windowEdges, int commitEnd, bool last);
+	void deleteWindow(ProblemData *window);
+	void addEdge(int sJob, int dJob, int sTime, int dTime, int eqType);
+};
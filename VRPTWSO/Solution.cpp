@@ -1,108 +1,138 @@
-#include "Solution.h"
-
-Solution::Solution()
-{
-	parameters = GlobalParameters::getInstance();
-	network = vector<vector<Vertex*>>(parameters->getNumJobs(), vector<Vertex*>(parameters->getHorizonLength()+1,nullptr));
-}
-
-Solution::~Solution()
-{
-	network.clear();
-}
-
-void Solution::addEdge(int sJob, int dJob, int sTime, int dTime, int eqType){
-	Vertex *v, *o;
-	if(network[sJob][sTime] == nullptr){
-		v = new Vertex(parameters->getNumEquipments());
-		v->setJob(sJob);
-		v->setTime(sTime);
-		network[sJob][sTime] = v;
-	}
-
-	v = network[sJob][sTime];
-
-	if(network[dJob][dTime] == nullptr){
-		o = new Vertex(parameters->getNumEquipments());
-		o->setJob(dJob);
-		o->setTime(dTime);
-		network[dJob][dTime] = o;
-	}
-
-	o = network[dJob][dTime];
-
-	v->addAdjacentVertex(eqType,o);
-	o->addInicidentVertex(eqType,v);
-}
-
-string Solution::toString(){
-	stringstream output;
-
-	if(network[0][0] != nullptr){
-		output << "---------------------------------------------" << endl;
-		output << "Solution value: " << solutionVal << endl;
-		output << "Selected Routes: " << endl;
-
-		Vertex *v, *o, *depot;
-		vector<Vertex*> myStack;
-		depot = network[0][0];
-		int contRoutes = 0;
-
-		for(int eqType=0; eqType<parameters->getNumEquipments(); eqType++){
-			vector<vector<bool>> visited = vector<vector<bool>>(parameters->getNumJobs(), vector<bool>(parameters->getHorizonLength() +1, false));
-			myStack.push_back(depot);
-			while(myStack.size() > 0){
-				v = myStack.back();
-				myStack.pop_back();
-				if(v->getJob() == 0 && v->getTime() != 0){ //end of a route
-					output << "(" << v->getJob() << ")" << endl;
-					myStack.push_back(depot);
-				}else if(v->getJob() == 0 && v->getTime() == 0){ //begin of a route (depot)
-					//Try to add an adjacent vertex
-					vector<Vertex*>::iterator it = v->getAdjacenceList(eqType).begin();
-					while(it != v->getAdjacenceList(eqType).end()){
-						o = (*it);
-						if(!visited[o->getJob()][o->getTime()]){
-							myStack.push_back(o);
-							visited[o->getJob()][o->getTime()] = true;
-							output << "Route " << contRoutes++ << ": (" << v->getJob() << "," << o->getJob() << "," << v->getTime() << ")"; 
-							break;
-						}
-						it++;
-					}
-				}else{
-					//This vertex should have an adjacent vertex, find it and add it.
-					if(v->getAdjacenceList(eqType).size() > 0){
-						vector<Vertex*>::iterator it = v->getAdjacenceList(eqType).begin();
-						while(it != v->getAdjacenceList(eqType).end()){
-							o = (*it);
-							if(!visited[o->getJob()][o->getTime()]){
-								if(o->getJob() != 0) //back to depot
-									visited[o->getJob()][o->getTime()] = true;
-								myStack.push_back(o);								
-								output << "(" << v->getJob() << "," << o->getJob() << "," << v->getTime() << ")"; 
-								break;
-							}
-							it++;
-						}
-					}else{
-						//look for exit from the same job, later in time
-						for(int t=v->getTime()+1; t<= parameters->getHorizonLength(); t++){
-							if(network[v->getJob()][t] != nullptr){
-								visited[v->getJob()][t] = true;
-								myStack.push_back(network[v->getJob()][t]);
-							}
-						}
-					}
-				}
-			}
-			myStack.clear();
-		}
-
-		output << "---------------------------------------------" << endl;
-	}else{
-		output << "ATENTION: Empty solution?" << endl;
-	}
-
-	return output.str();
+#include "Solution.h"
+
+Solution::Solution()
+{
+	parameters = GlobalParameters::getInstance();
+	network = VertexIndex(parameters->getNumJobs());
+}
+
+Solution::~Solution()
+{
+	//The vertices were created by addEdge
+	for(int j=0; j < parameters->getNumJobs(); j++){
+		for(int t=network.getFirstTime(j); t <= network.getLastTime(j); t++){
+			delete network.get(j, t);
+		}
+	}
+	network.clear();
+}
+
+void Solution::addEdge(int sJob, int dJob, int sTime, int dTime, int eqType){
+	Vertex *v, *o;
+	int edge[5] = {sJob, dJob, sTime, dTime, eqType};
+	edges.insert(edges.end(), edge, edge + 5);
+
+	if(network.get(sJob, sTime) == nullptr){
+		v = new Vertex(parameters->getNumEquipments());
+		v->setJob(sJob);
+		v->setTime(sTime);
+		network.add(v);
+	}
+
+	v = network.get(sJob, sTime);
+
+	if(network.get(dJob, dTime) == nullptr){
+		o = new Vertex(parameters->getNumEquipments());
+		o->setJob(dJob);
+		o->setTime(dTime);
+		network.add(o);
+	}
+
+	o = network.get(dJob, dTime);
+
+	v->addAdjacentVertex(eqType,o);
+	o->addInicidentVertex(eqType,v);
+}
+
+void Solution::write(ostream &out)
+{
+	int size = edges.size();
+	out.write((char*)&solutionVal, sizeof(double));
+	out.write((char*)&size, sizeof(int));
+	if(size > 0) out.write((char*)&edges[0], size * sizeof(int));
+}
+
+void Solution::read(istream &in)
+{
+	int size;
+	in.read((char*)&solutionVal, sizeof(double));
+	in.read((char*)&size, sizeof(int));
+
+	vector<int> values = vector<int>(size);
+	if(size > 0) in.read((char*)&values[0], size * sizeof(int));
+	for(int i=0; i + 4 < size; i += 5){
+		addEdge(values[i], values[i+1], values[i+2], values[i+3], values[i+4]);
+	}
+}
+
+string Solution::toString(){
+	stringstream output;
+
+	if(network.get(0, 0) != nullptr){
+		output << "---------------------------------------------" << endl;
+		output << "Solution value: " << solutionVal << endl;
+		output << "Selected Routes: " << endl;
+
+		Vertex *v, *o, *depot;
+		vector<Vertex*> myStack;
+		depot = network.get(0, 0);
+		int contRoutes = 0;
+
+		for(int eqType=0; eqType<parameters->getNumEquipments(); eqType++){
+			set<Vertex*> visited;
+			myStack.push_back(depot);
+			while(myStack.size() > 0){
+				v = myStack.back();
+				myStack.pop_back();
+				if(v->getJob() == 0 && v->getTime() == parameters->getHorizonLength()){ //end of a route
+					output << "(" << v->getJob() << ")" << endl;
+					myStack.push_back(depot);
+				}else if(v->getJob() == 0 && v->getTime() == 0){ //begin of a route (depot)
+					//Try to add an adjacent vertex
+					vector<Vertex*>::iterator it = v->getAdjacenceList(eqType).begin();
+					while(it != v->getAdjacenceList(eqType).end()){
+						o = (*it);
+						if(visited.count(o) == 0){
+							myStack.push_back(o);
+							visited.insert(o);
+							output << "Route " << contRoutes++ << ": (" << v->getJob() << "," << o->getJob() << "," << v->getTime() << ")"; 
+							break;
+						}
+						it++;
+					}
+				}else{
+					//This vertex should have an adjacent vertex, find it and add it.
+					if(v->getAdjacenceList(eqType).size() > 0){
+						vector<Vertex*>::iterator it = v->getAdjacenceList(eqType).begin();
+						while(it != v->getAdjacenceList(eqType).end()){
+							o = (*it);
+							if(visited.count(o) == 0){
+								if(o->getJob() != 0) //back to depot
+									visited.insert(o);
+								myStack.push_back(o);								
+								output << "(" << v->getJob() << "," << o->getJob() << "," << v->getTime() << ")"; 
+								break;
+							}
+							it++;
+						}
+					}else{
+						//look for exit from the same job, later in time
+						for(int t=v->getTime()+1; t<= network.getLastTime(v->getJob()); t++){
+							if(network.get(v->getJob(), t) != nullptr){
+								visited.insert(network.get(v->getJob(), t));
+								myStack.push_back(network.get(v->getJob(), t));
+							}
+						}
+					}
+				}
+			}
+			myStack.clear();
+		}
+
+		output << "---------------------------------------------" << endl;
+	}else{
+		output << "ATENTION: Empty solution?" << endl;
+	}
+
+	return output.str();
 }
\ No newline at end of file
@@ -1,34 +1,51 @@
-#pragma once
-
-#include "Bucket.h"
-#include <string>
-#include <sstream>
-#include <vector>
-
-using namespace std;
-
-class Solution
-{
-public:
-	Solution();
-	~Solution();
-
-	//GET METHODS
-	double getSolutionValue() const { return solutionVal; }
-
-	//SET METHODS
-	void setSolutionValue(double val){ solutionVal = val; }
-	void addEdge(int sJob, int dJob, int sTime, int dTime, int eqType);
-
-	//OPERATORS
-	bool operator<(const Solution *sol) const{
-		return this->getSolutionValue() < sol->getSolutionValue();
-	}
-
-	string toString();
-
-private:
-	GlobalParameters *parameters;
-	double solutionVal;
-	vector<vector<Vertex*>> network;
+#pragma once
+
+#include "Bucket.h"
+#include <string>
+#include <sstream>
+#include <vector>
+#include <iostream>
+#include <set>
+
+using namespace std;
+
+class Solution
+{
+public:
+	Solution();
+	~Solution();
+
+	//GET METHODS
+	double getSolutionValue() const { return solutionVal; }
+
+	//SET METHODS
+	void setSolutionValue(double val){ solutionVal = val; }
+	void addEdge(int sJob, int dJob, int sTime, int dTime, int eqType);
+	const vector<int> &getEdges() const { return edges; }
+
+	//Checkpoints
+	void write(ostream &out);
+	void read(istream &in);
+
+	//OPERATORS
+	bool operator<(const Solution *sol) const{
+		return this->getSolutionValue() < sol->getSolutionValue();
+	}
+
+	string toString();
+
+private:
+	GlobalParameters *parameters;
+	double solutionVal;
+	VertexIndex network;
+	//Edges as added (sJob, dJob, sTime, dTime, eqType)
+	vector<int> edges;
+};
+
+class SolutionComparator
+{
+public:
+	bool operator()(const Solution *s1, const Solution *s2){
+		return s1->getSolutionValue() < s2->getSolutionValue();
+	}
 };
\ No newline at end of file
@@ -1,983 +1,1970 @@
-#include "Solver.h"
-#include "SubproblemSolver.h"
-#include "Bucket.h"
-#include "Route.h"
-#include "Node.h"
-
-#include <sstream>
-#include <iomanip>
-#include <vector>
-#include <queue>
-
-string itos(int i) {stringstream s; s << i; return s.str(); }
-
-Solver::Solver(ProblemData *d) : data(d)
-{
-	//Get global parameters
-	parameters = GlobalParameters::getInstance();
-
-	//Create Gurobi enviroment and model
-	env = new GRBEnv();
-	model = new GRBModel(*env);	
-
-	//Objective function value of auxiliary variables
-	bigM = parameters->getBigM();
-	
-	//Initialize subproblem solver vector
-	spSolver = new SubproblemSolver(data, QROUTE_NOLOOP);	
-
-	//Solutions set
-	solutions = set<Solution*>();
-}
-
-Solver::~Solver()
-{
-	//Destroy subproblem solver
-	delete spSolver;
-
-	//Destroy variable hash map
-	vHash.clear();
-
-	//Destroy constraint hash map
-	cHash.clear();
-	
-	//Destroy Gurobi Enviroment
-	delete env;
-}
-
-int Solver::solve()
-{
-	int status = GRB_INPROGRESS;
-	eDualVars = 0;
-	cDualVars = 0;
-
-	//Global parameters
-	ZInc = 1e13;
-	totalNodes = 0;
-	exploredNodes = 0;
-	routeCounter = 0;
-
-	//Build problem graph representation
-	buildProblemNetwork();
-
-	//Build the initial model
-	buildInitialModel();
-
-	//Get a first integer feasible solution (ZInc)
-	GRBEnv myEnv = model->getEnv();
-	myEnv.set(GRB_IntParam_Method, GRB_METHOD_BARRIER);
-	myEnv.set(GRB_IntParam_MIPFocus, 1);
-	myEnv.set(GRB_IntParam_SolutionLimit, 1);
-	myEnv.set(GRB_DoubleParam_Heuristics, 1);
-	myEnv.set(GRB_IntParam_RINS, 1);
-	myEnv.set(GRB_IntParam_ZeroObjNodes, 1);
-	myEnv.set(GRB_IntParam_PumpPasses, 1);
-
-	//Create tempNode to get a first ZInc from ovf formulation
-	Node *tempNode = new Node(cDualVars, eDualVars);
-	tempNode->setModel(model);
-	tempNode->setVHash(vHash);
-	tempNode->setCHash(cHash);
-
-	int s = tempNode->solve();
-	tempNode->printSolution();
-	ZInc = tempNode->getZLP();
-	cout << "Solution status: " << s << " - ZInc = " << ZInc << endl;
-	delete tempNode;
-
-	//Disable gurobi output
-	myEnv.set(GRB_IntParam_OutputFlag,0);
-
-	//Build Explicit DWM model
-	buildDWM();
-
-	Node *rootNode = new Node(cDualVars,eDualVars);
-	rootNode->setModel(model);
-	rootNode->setVHash(vHash);
-	rootNode->setCHash(cHash);
-
-	//At this point, root node has its own copy of the model
-	delete model;
-	vHash.clear();
-	cHash.clear();
-
-	//Solve DWM model by CG
-	tStart = clock();
-	status = BaP(rootNode);
-
-	return status;
-}
-
-void Solver::buildInitialModel()
-{
-	Job *job;
-	Equipment *e;
-	int tInit, tEnd;
-	int cont;
-	int contVars = 0;
-	int contCons = 0;
-
-	cout << "*******************" << endl;
-	cout << "Creating ovf model." << endl;
-	cout << "*******************" << endl;
-
-	//----------------
-	//CREATE VARIABLES
-	//----------------
-	Variable v, y, x, w;
-
-	cont = 0;
-	cout << "Creating y vars." << endl;
-	//yVars
-	for(int j=1; j < data->numJobs; j++){ //job 0 does not have an Y var
-		job = data->jobs[j];
-		tInit = job->getFirstStartTimePeriod();
-		tEnd = job->getLastStartTimePeriod();
-
-		for(int t=tInit; t <= tEnd; t++){
-			y.reset();
-			y.setType(V_Y);
-			y.setStartJob(j);
-			y.setTime(t);
-
-			vHash[y] = true;
-			model->addVar(0.0,1.0,0.0,GRB_INTEGER,y.toString());
-			cont++;
-		}
-	}
-	cout << "Total y Vars created: " << cont << endl;
-	contVars += cont;
-
-	//xVars and wVars
-	int contw = 0;
-	cont = 0;
-	cout << "Creating x and w vars." << endl;
-	queue<Vertex*> myQueue;
-	for(int eqType=0; eqType < data->numEquipments; eqType++){
-		e = data->equipments[eqType];
-
-		//Make a BFS over the problem network
-		Vertex *o, *d;
-		vector<vector<bool>> visited = vector<vector<bool>>(data->numJobs, vector<bool>(data->horizonLength+1,false));
-
-		o = data->problemNetwork[0][0]; //depot
-		myQueue.push(o);
-
-		while(myQueue.size() > 0){
-			o = myQueue.front();			
-			myQueue.pop();
-
-			int oJob = o->getJob();
-			int oTime = o->getTime();
-
-			int sourceReq = data->jobs[oJob]->getEquipmentTypeRequired(eqType);
-
-			if(!visited[oJob][oTime]){
-				visited[oJob][oTime] = true;
-
-				//Iterate through adjacence list for job o and eqType
-				vector<Vertex*>::iterator it = o->getAdjacenceList(eqType).begin();
-				vector<Vertex*>::iterator eit = o->getAdjacenceList(eqType).end();
-				for(; it != eit; it++){
-					d = (*it);
-					int dJob = d->getJob();
-					int dTime = d->getTime();
-
-					int destinationReq = data->jobs[dJob]->getEquipmentTypeRequired(eqType);
-					double transitionTime = e->getNotRoundedTransitionTime(oJob,dJob);
-
-					//CREATE VARS
-					if(oJob != dJob){ //not waiting					
-						//create xVar
-						x.reset();
-						x.setType(V_X);
-						x.setStartJob(o->getJob());
-						x.setEndJob(d->getJob());
-						x.setTime(o->getTime());
-						x.setArrivalTime(d->getTime());
-						x.setEquipmentTipe(eqType);
-
-						if(vHash.find(x) == vHash.end()){
-							vHash[x] = true;
-							model->addVar(0.0,1.0,transitionTime,GRB_INTEGER, x.toString());
-							cont++;
-						}					
-					}else{
-						w.reset();
-						w.setType(V_W);
-						w.setStartJob(o->getJob());
-						w.setTime(o->getTime());
-						w.setEquipmentTipe(eqType);
-
-						if(vHash.find(w) == vHash.end()){
-							vHash[w] = true;
-							model->addVar(0.0,1.0,0.0,GRB_INTEGER,w.toString());
-							contw++;
-						}
-					}
-					myQueue.push(d);
-				}
-			}
-		}
-		visited.clear();
-	}
-	
-	contVars += cont + contw;
-
-	model->update();
-	cout << "Total x Vars created: " << cont << endl;
-	cout << "Total w Vars created: " << contw << endl;
-	cout << "Total Variables: " << contVars << endl;
-	//----------------------
-
-	//----------------------
-	//CREATE CONSTRAINTS
-	//----------------------
-	GRBVar var1, var2;
-	Constraint c1, c2;
-
-	cont = 0;
-	cout << "Creating cover constraints." << endl;
-	//Cover Constraints
-	for(int j=1; j < data->numJobs; j++){
-		GRBLinExpr expr = 0;
-
-		c1.reset();
-		c1.setType(C_COVER);
-		c1.setStartJob(j);
-
-		if(cHash.find(c1) == cHash.end()){
-			for(int t=0; t <= data->horizonLength; t++){
-				y.reset();
-				y.setType(V_Y);
-				y.setStartJob(j);
-				y.setTime(t);
-
-				if(vHash.find(y) != vHash.end()){
-					var1 = model->getVarByName(y.toString());
-					expr += var1;
-				}
-			}
-			cHash[c1] = true;
-			model->addConstr(expr == 1, c1.toString());
-			cont ++;
-		}
-	}
-	contCons += cont;
-	cout << "Total cover constraints created: " << cont << endl;
-
-	cout << "Creating synchronization constraints." << endl;
-	cont = 0;
-	//Synchronization Constraints
-	for(int j=1; j < data->numJobs; j++){
-		job = data->jobs[j];
-		tInit = job->getFirstStartTimePeriod();
-		tEnd = job->getLastStartTimePeriod();
-		for(int t=tInit; t <= tEnd; t++){
-			//Get y variable
-			y.reset();
-			y.setType(V_Y);
-			y.setStartJob(j);
-			y.setTime(t);
-
-			if(vHash.find(y) == vHash.end()) continue; //job cannot be attended at time period t, so go to t+1
-			var1 = model->getVarByName(y.toString());
-
-			for(int eqType=0; eqType < data->numEquipments; eqType++){
-				//Verify that job j requires eqType
-				if(job->getEquipmentTypeRequired(eqType) <= 0) continue;				
-
-				c1.reset();
-				c1.setType(C_SYNCH);
-				c1.setStartJob(j);
-				c1.setTime(t);
-				c1.setEquipmentType(eqType);
-
-				if(cHash.find(c1) == cHash.end()){
-					GRBLinExpr expr = 0;				
-					expr -= var1;
-
-					for(int i=0; i < data->numJobs; i++){
-						//Get x Variable
-						x.reset();
-						x.setType(V_X);
-						x.setStartJob(j);
-						x.setEndJob(i);
-						x.setTime(t);
-						x.setEquipmentTipe(eqType);
-
-						if(vHash.find(x) != vHash.end()){
-							var2 = model->getVarByName(x.toString());
-							expr += var2;
-						}
-					}
-
-					cHash[c1] = true;
-					model->addConstr(expr == 0, c1.toString());
-					cont ++;
-				}
-			}
-		}
-	}
-	contCons += cont;
-	cout << "Total synchronization constraints created: " << cont << endl;
-
-	cont = 0;
-	cout << "Creating flow init constraints." << endl;
-	//Fow Init constraints
-	for(int eqType=0; eqType < data->numEquipments; eqType++){
-		e = data->equipments[eqType];
-		
-		c1.reset();
-		c1.setType(C_OVF_FLOW_INIT);
-		c1.setEquipmentType(eqType);
-
-		if(cHash.find(c1) != cHash.end()) continue;
-
-		GRBLinExpr expr = 0;
-
-		for(int j=1; j < data->numJobs; j++){
-			x.reset();
-			x.setType(V_X);
-			x.setStartJob(0);
-			x.setEndJob(j);
-			x.setTime(0);
-			x.setEquipmentTipe(eqType);
-
-			if(vHash.find(x) != vHash.end()){
-				var1 = model->getVarByName(x.toString());
-				expr += var1;				
-			}
-		}
-
-		cHash[c1] = true;
-		model->addConstr(expr == e->getNumMachines(), c1.toString());
-		cont ++;
-	}
-	contCons += cont;
-	cout << "Total flow init constraints created: " << cont << endl;
-
-	cont = 0;
-	cout << "Creating flow constraints." << endl;
-	vector<Vertex*>::iterator it, eit;
-	//Create Flow constraints
-	for(int eqType=0; eqType < data->numEquipments; eqType++){
-		e = data->equipments[eqType];
-		for(int j=1; j<data->numJobs; j++){
-			job = data->jobs[j];
-
-			if(job->getEquipmentTypeRequired(eqType) <= 0) continue;
-
-			tInit = min(job->getFirstStartTimePeriod(),(int)e->getTransitionTime(0,j));
-			tEnd = job->getLastStartTimePeriod();
-
-			for(int t = tInit; t <= tEnd; t++){
-				c1.reset();
-				c1.setType(C_OVF_FLOW);
-				c1.setStartJob(j);
-				c1.setTime(t);
-				c1.setEquipmentType(eqType);
-
-				if(cHash.find(c1) == cHash.end()){
-					GRBLinExpr expr = 0;
-
-					//Leaving variables (+)
-					it = data->problemNetwork[j][t]->getAdjacenceList(eqType).begin();
-					eit = data->problemNetwork[j][t]->getAdjacenceList(eqType).end();
-
-					for(; it != eit; it++){
-						int i = (*it)->getJob();
-						
-						if(i != j){ //transition
-							//Get x variable
-							v.reset();
-							v.setType(V_X);
-							v.setStartJob(j);
-							v.setEndJob(i);
-							v.setTime(t);
-							v.setEquipmentTipe(eqType);
-
-							if(vHash.find(v) != vHash.end()){
-								var1 = model->getVarByName(v.toString());
-								expr += var1;
-							}
-						}else{ //waiting
-							//Get w variable
-							v.reset();
-							v.setType(V_W);
-							v.setStartJob(j);
-							v.setTime(t);
-							v.setEquipmentTipe(eqType);
-
-							if(vHash.find(v) != vHash.end()){
-								var1 = model->getVarByName(v.toString());
-								expr += var1;
-							}
-						}
-					}
-
-					//Entering variaveis (-)
-					it = data->problemNetwork[j][t]->getIncidenceList(eqType).begin();
-					eit = data->problemNetwork[j][t]->getIncidenceList(eqType).end();
-
-					for(; it != eit; it++){
-						int i = (*it)->getJob();
-						int t1 = (*it)->getTime();
-
-						if(i != j){ //Transition
-							//Get x variable
-							v.reset();
-							v.setType(V_X);
-							v.setStartJob(i);
-							v.setEndJob(j);
-							v.setTime(t1);
-							v.setEquipmentTipe(eqType);
-
-							if(vHash.find(v) != vHash.end()){
-								var1 = model->getVarByName(v.toString());
-								expr -= var1;
-							}
-						}else{ //Waiting
-							//Get w Variable
-							v.reset();
-							v.setType(V_W);
-							v.setStartJob(j);
-							v.setTime(t1);
-							v.setEquipmentTipe(eqType);
-
-							if(vHash.find(v) != vHash.end()){
-								var1 = model->getVarByName(v.toString());
-								expr -= var1;
-							}
-						}
-					}
-
-					cHash[c1] = true;
-					model->addConstr(expr == 0, c1.toString());
-					cont ++; 
-				}
-			}
-		}
-	}
-	contCons += cont;
-	cout << "Total flow constraints created: " << cont << endl;
-	cout << "Total constraints in OVF: " << contCons << endl;
-
-	model->update();
-	//----------------------
-	
-	model->write("modelo_OVF.lp");
-}
-
-void Solver::buildDWM()
-{		
-	int cont;
-	int contVars = 0;
-	int contCons = 0;
-
-	GRBVar var1, var2;
-	GRBConstr cons;
-
-	Constraint c;
-	Variable v, b, f;
-
-	cout << "****************************" << endl;
-	cout << "Creating explicit dwm model." << endl;
-	cout << "****************************" << endl;
-
-	//Relax integer variables
-	
-	cout << "Deleting w (ovf) variables, relaxing y and x variaveis." << endl;
-	//Delete w variables
-	VariableHash::iterator vit = vHash.begin();
-	while(vit != vHash.end()){
-		v = vit->first;
-		var1 = model->getVarByName(v.toString());
-
-		if(v.getType() == V_W){ 
-			model->remove(var1);
-			vHash.erase(vit++);
-		}else{
-			if(v.getType() == V_X){
-				//Relax integer x variable
-				var1.set(GRB_CharAttr_VType, GRB_CONTINUOUS);				
-			}else if(v.getType() == V_Y){
-				//Relax integer variable
-				var1.set(GRB_CharAttr_VType, GRB_CONTINUOUS);
-			}
-			vit++;
-		}
-	}
-
-	cont = 0;
-	cout << "Creating b auxilaty variables." << endl;
-	//Create bAux vars
-	for(int i=0; i< data->numJobs; i++){
-		for(int j=0; j<data->numJobs; j++){
-			for(int t=0; t < data->horizonLength; t++){
-				for(int eqType = 0; eqType < data->numEquipments; eqType++){
-					v.reset();
-					v.setType(V_X);
-					v.setStartJob(i);
-					v.setEndJob(j);
-					v.setTime(t);
-					v.setEquipmentTipe(eqType);
-
-					if(vHash.find(v) == vHash.end()) continue;
-
-					b.reset();
-					b.setType(V_BAUX);
-					b.setStartJob(i);
-					b.setEndJob(j);
-					b.setTime(t);
-					b.setEquipmentTipe(eqType);
-
-					if(vHash.find(b) == vHash.end()){
-						vHash[b] = true;
-						model->addVar(0.0,1.0,bigM,GRB_CONTINUOUS,b.toString());
-						cont ++;
-					}
-				}
-			}
-		}
-	}
-	contVars += cont;
-	cout << "Total b aux variables created: " << cout << endl;
-	
-	cont = 0;
-	cout << "Creating f auxiliary variables." << endl;
-	//fAuxVar
-	for(int eqType=0; eqType < data->numEquipments; eqType++){
-		Equipment *e = data->equipments[eqType];
-
-		f.reset();
-		f.setType(V_FAUX);
-		f.setEquipmentTipe(eqType);
-
-		vHash[f] = true;
-		model->addVar(0.0,e->getNumMachines(),bigM,GRB_CONTINUOUS, f.toString());
-		cont ++;
-	}
-	contVars += cont;
-	cout << "Total f aux variables created: " << cont << endl;
-	cout << "Total auxiliary variables created in dwm: " << contVars << endl;
-
-	model->update();
-	//----------------------
-
-	//-----------------------------
-	//ERASE SUBPROBLEM CONSTRAINTS
-	//-----------------------------	
-	cout << "Erasing subproblem constraints (flow)." << endl;
-	ConstraintHash::iterator cit = cHash.begin();
-
-	while(cit != cHash.end()){
-		c = cit->first;
-
-		if(c.getType() == C_OVF_FLOW || c.getType() == C_OVF_FLOW_INIT){
-			cons = model->getConstrByName(c.toString());
-			cHash.erase(cit++);
-			model->remove(cons);
-		}else{
-			cit++;
-		}
-	}
-	model->update();
-	//----------------------
-
-	//----------------------
-	//CREATE CONSTRAINTS
-	//----------------------
-	cont = 0;
-	cout << "Creating route number constraints." << endl;
-	//Cardinality constraints
-	for(int eqType=0; eqType < data->numEquipments; eqType++){
-		Equipment *e = data->equipments[eqType];
-		
-		GRBLinExpr expr = 0;
-
-		c.reset();
-		c.setType(C_CARD);
-		c.setEquipmentType(eqType);
-		c.setId(cont);
-
-		f.reset();
-		f.setType(V_FAUX);
-		f.setEquipmentTipe(eqType);
-
-		if(cHash.find(c) == cHash.end() && vHash.find(f) != vHash.end()){
-			var1 = model->getVarByName(f.toString());
-			expr += var1;
-			cHash[c] = true;
-			model->addConstr(expr == e->getNumMachines(), c.toString());
-			cont++;
-		}
-	}
-	cDualVars = cont;
-	contCons += cont;
-	cout << "Convex constraints created: " << cont << endl;
-	
-	cont = 0;
-	cout << "Creating explicit master constraints." << endl;
-	//Explicit master constraints
-	for(int i=0; i < data->numJobs; i++){
-		Job *iJob = data->jobs[i];
-		for(int j=0; j < data->numJobs; j++){
-			for(int t=iJob->getFirstStartTimePeriod(); t <= iJob->getLastStartTimePeriod(); t++){
-				for(int eqType=0; eqType < data->numEquipments; eqType++){
-					GRBLinExpr expr = 0;
-
-					c.reset();
-					c.setType(C_EXPLICIT);
-					c.setStartJob(i);
-					c.setEndJob(j);
-					c.setTime(t);
-					c.setEquipmentType(eqType);
-					c.setId(cont);
-
-					v.reset();
-					v.setType(V_X);
-					v.setStartJob(i);
-					v.setEndJob(j);
-					v.setTime(t);
-					v.setEquipmentTipe(eqType);
-
-					b.reset();
-					b.setType(V_BAUX);
-					b.setStartJob(i);
-					b.setEndJob(j);
-					b.setTime(t);
-					b.setEquipmentTipe(eqType);
-
-					if(cHash.find(c) == cHash.end() && vHash.find(v) != vHash.end() && vHash.find(b) != vHash.end()){
-						var1 = model->getVarByName(v.toString());
-						var2 = model->getVarByName(b.toString());
-						expr += var1;
-						expr -= var2;
-						cHash[c] = true;
-						model->addConstr(expr == 0, c.toString());
-						cont ++;
-					}
-
-				}
-			}
-		}
-	}
-	eDualVars = cont;
-	contCons += cont;
-	cout << "Total explicit master constraints: " << cont << endl;
-	cout << "Total constraints specific to the DWM: " << cont << endl;
-
-	model->update();
-	//----------------------
-
-	model->write("modelo_EDWM.lp");
-}
-
-int Solver::solveLPByColumnGeneration(Node *node, int treeSize)
-{
-	int status = GRB_INPROGRESS;
-	double Zlp = 1e13;
-	double lagrangeanBound = 0.0;
-	int fixatedVars;
-	int totalFixatedVars = 0;
-	int rCount;
-	int totalRoutes = 0;
-	double minRouteCost = 0.0;
-	int iteration = 0;
-
-	//Reset subproblem solver and collapse vertices
-	spSolver->reset();
-	Route *myRoute;
-	vector<Route*> generatedRoutes = vector<Route*>();
-	vector<Route*>::iterator rit, eit;
-	//spSolver->collapseVertices();
-
-	//Dynamically solve the model by column generation.
-	bool end = false;
-	while(!end){
-		stringstream output;
-
-		//Solve current model
-		iteration ++;
-		status = node->solve();	
-
-		if(status == GRB_OPTIMAL){
-			int sw = 0;		
-			
-			rCount = 0;
-			fixatedVars = 0;
-			double Zlp = node->getZLP();
-			lagrangeanBound = ZInc - Zlp;
-
-			//Generate routes for each equipment type
-			for(int eqType = 0; eqType < data->numEquipments; eqType++){
-				Equipment *e = data->equipments[eqType];					
-				minRouteCost = 0.0;
-				
-				spSolver->solve(node, eqType, 10);
-				if(spSolver->isInfeasible()){
-					return GRB_INFEASIBLE;
-				}
-
-				//Verify that at least 1 route was generated
-				if(spSolver->routes.size() == 0) continue;
-
-				//Append routes to generated routes vector
-				minRouteCost = spSolver->routes[0]->getCost();
-				generatedRoutes.insert(generatedRoutes.end(),spSolver->routes.begin(),spSolver->routes.end());
-				lagrangeanBound -= (e->getNumMachines() * minRouteCost);
-			}
-
-			//If no routes where generated, the current lp solution is optimal
-			if(generatedRoutes.size() == 0){
-				if(parameters->useDualStabilization()){
-					if(node->getMaxPiDifference() <= parameters->getEpsilon()){
-						end = true;
-					}else{
-						cout << "No route found. Updating Pi" << endl;
-						node->updatePi();
-						continue;
-					}
-				}else{
-					end = true;
-				}
-			}else{
-				//fix variables by reduced cost.
-				if(iteration % 10 == 0){
-					//fixatedVars = node->fixVarsByReducedCost(lagrangeanBound);
-					totalFixatedVars += fixatedVars;
-				}
-
-				//Add routes to the model
-				rit = generatedRoutes.begin();
-				eit = generatedRoutes.end();
-				for(; rit != eit; rit++){
-					myRoute = (*rit);
-					myRoute->setRouteNumber(routeCounter++);
-					//cout << myRoute->toString() << endl;
-					if(!node->addColumn(myRoute)){
-						cout << "Error: column " << myRoute->getRouteNumber() << "," 
-							<< myRoute->getEquipmentType() << " already existed in node " << node->getNodeId() << endl;
-					}
-					delete myRoute;
-					rCount ++;
-					totalRoutes ++;
-				}					
-				generatedRoutes.clear();
-			}
-
-			if(iteration % 5 == 0 || end){
-				output << left;
-				output << "| " << "Id: " << setw(4) << node->getNodeId() << " Unexp: " << setw(4) << treeSize << " Iter: " << setw(5) << iteration;
-				output << "| " << "Zlp: " << setw(7) << Zlp << " ZInc: " << setw(7) << ZInc;
-				output << "| " << "Routes: " << setw(5) << rCount << "Total: " << setw(5) << totalRoutes << " MinRC: " << setw(10) << minRouteCost;
-				output << "| " << "LagBound: " << setw(10) << lagrangeanBound << " Fix: " << setw(4) << fixatedVars << " TFix: " << setw(5) << totalFixatedVars;
-				output << "| " << "Time: " << setw(5)  << (double)(clock() - tStart)/CLOCKS_PER_SEC << "s | ";
-
-				cout << output.str() << endl;
-			}
-		}else{ //INFEASIBLE
-			node->getModel()->write("modelo_inf.lp");
-			cout << "Infeasible" << endl;
-			return GRB_INFEASIBLE;
-		}
-	}
-
-	//node->printSolution();
-	return status;
-}
-
-int Solver::BaP(Node *node)
-{	
-	int status = GRB_INPROGRESS;
-	exploredNodes = 0;
-	
-	vector<Node*> myStack = vector<Node*>();
-	myStack.push_back(node);
-	Node *currentNode;
-
-	string sep = "-------------------------------------------------------------------";
-	cout << sep << endl;
-	cout << "Starting branch and price algorithm. Initial Incumbent: " << ZInc << endl;
-	cout << sep << endl;
-
-	while(myStack.size() > 0){
-		currentNode = myStack.back();
-		myStack.pop_back();
-		exploredNodes++;
-
-		cout << sep << endl;
-		cout << "Starting column generation on node " << exploredNodes << endl;
-
-		currentNode->setNodeId(exploredNodes);
-		status = solveLPByColumnGeneration(currentNode, myStack.size());
-
-		cout << "Column generation on node " << exploredNodes << " completed." << endl;
-		cout << sep << endl;
-
-		if(status != GRB_OPTIMAL){
-			cout << "Node " << exploredNodes << " INFEASIBLE. " << endl;
-			delete currentNode;
-			continue;
-		}else{
-			double Zlp = currentNode->getZLP();
-			if(currentNode->isIntegerSolution()){
-				if(Zlp < ZInc || solutions.size() == 0){
-					Solution *s = currentNode->getSolution();
-					
-					cout << sep << endl;
-					cout << "NEW INCUMBENT FOUND: " << endl;
-					cout << s->toString() << endl;
-					cout << sep << endl;
-
-					solutions.insert(s);
-					ZInc = Zlp;
-				}
-				continue;
-			}else if(ceil(Zlp) >= ZInc && exploredNodes > 1){
-				cout << "Node " << exploredNodes << " PRUNED BY BOUND. " << ceil(Zlp) << " > " << ZInc << endl;
-				delete currentNode;
-				continue;
-			}
-		}
-		
-		//Node cleaning
-		cout << sep << endl;
-		cout << "Cleaning node. " << endl;
-		int cleaned = currentNode->cleanNode(500);
-		cout << cleaned << " routes eliminated." << endl;
-		cout << sep << endl;
-
-		//Fix by reduced costs.
-		cout << sep << endl;
-		cout << "Fixating variables by reduced cost before branching. " << endl;
-		int fix = currentNode->fixVarsByReducedCost(ZInc - currentNode->getZLP());
-		cout << fix << " variables eliminated." << endl;
-		cout << sep << endl;
-
-		//Get branching candidate
-		Variable branchV = currentNode->getMostFractional();
-		cout << sep << endl;
-		cout << "Branching on variable: " << branchV.toString() << endl;
-		cout << sep << endl;
-
-		//Add two nodes to the stack
-		Node *nodeIzq = new Node(*currentNode);
-		Node *nodeDer = new Node(*currentNode);
-
-		nodeIzq->addBranchConstraint(branchV, 0.0);
-		nodeDer->addBranchConstraint(branchV, 1.0);
-
-		myStack.push_back(nodeIzq);
-		myStack.push_back(nodeDer);
-		
-		//parent node not needed anymore
-		delete currentNode;
-	}
-
-	if(solutions.size() > 0){
-		cout << sep << endl;
-		cout << "BEST SOLUTION FOUND: " << endl;
-		cout << (*solutions.begin())->toString() << endl;
-		cout << sep << endl;
-	}else{
-		cout << "ATENTION: No solution found =( " << endl;
-	}
-
-	return status;
-}
-
-void Solver::buildProblemNetwork()
-{
-	Vertex *s, *d;
-	queue<Vertex*> myQueue;
-
-	cout << "Creating problem network." << endl;
-
-	s = new Vertex(data->numEquipments);	
-	s->setJob(0);
-	s->setTime(0);
-
-	data->problemNetwork[0][0] = s;
-	data->vertexSet.insert(s);
-	myQueue.push(s);
-
-	while(myQueue.size() > 0){
-		s = myQueue.front();
-		Job *sJob = data->jobs[s->getJob()];
-		
-		for(int eqType=0; eqType < data->numEquipments; eqType++){
-			Equipment *e = data->equipments[eqType];
-
-			//Verify equipment requirement of job s
-			if(s->getJob() != 0 && !sJob->getEquipmentTypeRequired(eqType)) continue;	
-
-			//Verify that vertex s belongs to the time window of sJob (sJob can be attended at this time)
-			if(s->getTime() >= sJob->getFirstStartTimePeriod() && s->getTime() <= sJob->getLastStartTimePeriod()){
-				//create adjacence list for vertex s (other Jobs)
-				for(int j=1; j<data->numJobs; j++){
-					Job *jJob = data->jobs[j];
-
-					//Verify is not the same job
-					if(s->getJob() == j) continue;
-
-					//Verify equipment requirement of job j
-					if(!jJob->getEquipmentTypeRequired(eqType)) continue;			
-				
-					//Verify time window compatibility
-					int arriveTime = s->getTime() + sJob->getServiceTime() + (int)e->getTransitionTime(s->getJob(),j);
-					if(arriveTime > jJob->getLastStartTimePeriod()) continue;
-
-					if(data->problemNetwork[j][arriveTime] == nullptr){
-						data->problemNetwork[j][arriveTime] = new Vertex(data->numEquipments);
-						data->problemNetwork[j][arriveTime]->setJob(j);
-						data->problemNetwork[j][arriveTime]->setTime(arriveTime);
-						myQueue.push(data->problemNetwork[j][arriveTime]);
-						//Add vertex to topologically ordered set
-						data->vertexSet.insert(data->problemNetwork[j][arriveTime]);
-					}
-
-					d = data->problemNetwork[j][arriveTime];				
-
-					s->addAdjacentVertex(eqType,d);
-					d->addInicidentVertex(eqType,s);	
-				}
-
-				//Add return to depot to the adjacence list of job s
-				if(s->getJob() != 0){
-					if(data->problemNetwork[0][data->horizonLength] == nullptr){
-						data->problemNetwork[0][data->horizonLength] = new Vertex(data->numEquipments);
-						data->problemNetwork[0][data->horizonLength]->setJob(0);
-						data->problemNetwork[0][data->horizonLength]->setTime(data->horizonLength);
-						//Add vertex to topologically ordered set
-						data->vertexSet.insert(data->problemNetwork[0][data->horizonLength]);
-					}
-					d = data->problemNetwork[0][data->horizonLength];
-					s->addAdjacentVertex(eqType,d);
-					d->addInicidentVertex(eqType,s);
-				}
-			}
-
-			//Add same job at t+1 to adjacence list of s. (Waiting)
-			if(s->getJob() != 0 && sJob->getLastStartTimePeriod() > s->getTime())
-			{
-				if(data->problemNetwork[s->getJob()][s->getTime()+1] == nullptr)
-				{
-					data->problemNetwork[s->getJob()][s->getTime()+1] = new Vertex(data->numEquipments);
-					data->problemNetwork[s->getJob()][s->getTime()+1]->setJob(s->getJob());
-					data->problemNetwork[s->getJob()][s->getTime()+1]->setTime(s->getTime()+1);
-					myQueue.push(data->problemNetwork[s->getJob()][s->getTime()+1]);
-					//Add vertex to topologically ordered set
-					data->vertexSet.insert(data->problemNetwork[s->getJob()][s->getTime()+1]);
-				}
-				d = data->problemNetwork[s->getJob()][s->getTime()+1];
-
-				s->addAdjacentVertex(eqType,d);
-				d->addInicidentVertex(eqType,s);
-			}
-		}
-
-		myQueue.pop();
-	}
+#include "Solver.h"
+#include "SubproblemSolver.h"
+#include "Bucket.h"
+#include "Route.h"
+#include "Node.h"
+#include "ConstructiveHeuristic.h"
+
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <cstdio>
+#include <omp.h>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <chrono>
+
+string itos(int i) {stringstream s; s << i; return s.str(); }
+
+Solver::Solver(ProblemData *d) : data(d)
+{
+	//Get global parameters
+	parameters = GlobalParameters::getInstance();
+
+	//Create Gurobi enviroment and model
+	env = new GRBEnv();
+	model = new GRBModel(*env);	
+
+	//Objective function value of auxiliary variables
+	bigM = parameters->getBigM();
+	
+	//Subproblem solvers and worker enviroments are created once the network exists
+	spSolver = nullptr;
+	workerEnvs = vector<GRBEnv*>();
+	workerSolvers = vector<SubproblemSolver*>();
+	columnPool = nullptr;
+	cutPool = nullptr;
+	cutSeparator = nullptr;
+	nodeStore = nullptr;
+	omp_init_lock(&checkpointLock);
+
+	//Solutions set
+	solutions = set<Solution*,SolutionComparator>();
+}
+
+Solver::~Solver()
+{
+	//Destroy subproblem solver
+	delete spSolver;
+
+	//Destroy workers
+	for(unsigned int i=0; i < workerSolvers.size(); i++){
+		delete workerSolvers[i];
+		delete workerEnvs[i];
+	}
+	delete columnPool;
+	delete cutPool;
+	delete cutSeparator;
+	Node::setNodeStore(nullptr);
+	delete nodeStore;
+	omp_destroy_lock(&checkpointLock);
+
+	//Destroy variable hash map
+	vHash.clear();
+
+	//Destroy constraint hash map
+	cHash.clear();
+	
+	//Destroy Gurobi Enviroment
+	delete env;
+}
+
+int Solver::solve()
+{
+	int status = GRB_INPROGRESS;
+	eDualVars = 0;
+	cDualVars = 0;
+
+	//Global parameters
+	ZInc = 1e13;
+	totalNodes = 0;
+	exploredNodes = 0;
+	routeCounter = 0;
+
+	//A resumed run takes the incumbent and the open nodes from the checkpoint
+	bool resume = parameters->resumeFromCheckpoint();
+	bool ovf = false;
+	if(!resume){
+		//Get a first integer feasible solution (ZInc) by a constructive heuristic
+		status = getFeasibleSolution();
+
+		//The ovf formulation is solved on demand or when the heuristic fails
+		ovf = parameters->useOVFHeuristic() || status != GRB_OPTIMAL;
+	}
+
+	//With a partial discretization the start times of the initial routes must be in the network
+	if(parameters->useDynamicDiscretization()){
+		vector<Route*>::iterator rit = initialRoutes.begin();
+		for(; rit != initialRoutes.end(); rit++){
+			vector<Edge*>::iterator eit = (*rit)->edges.begin();
+			for(; eit != (*rit)->edges.end(); eit++){
+				if((*eit)->getStartJob() != 0) data->addTimePoint((*eit)->getStartJob(), (*eit)->getTime());
+			}
+		}
+	}
+
+	//Build problem graph representation
+	buildProblemNetwork();
+	spSolver = new SubproblemSolver(data, QROUTE_NOLOOP);
+	if(data->getNumNetworkShifts() > 1){
+		cout << "Work shift decomposition: " << data->getNumNetworkShifts() << " shifts of " << data->workShiftLength << " periods priced in parallel" << endl;
+	}
+	if(parameters->useContractedNetwork()){
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			cout << "Contracted pricing network (equipment " << eqType << "): " << spSolver->getNumPricingVertices(eqType);
+			cout << " event vertices of " << spSolver->getNumNetworkVertices(eqType) << endl;
+		}
+	}
+
+	//Build the initial model
+	buildInitialModel(ovf);
+
+	GRBEnv myEnv = model->getEnv();
+
+	//Get (or improve) ZInc with the first feasible solution of the ovf formulation
+	if(ovf){
+		myEnv.set(GRB_IntParam_Method, GRB_METHOD_BARRIER);
+		myEnv.set(GRB_IntParam_MIPFocus, 1);
+		myEnv.set(GRB_IntParam_SolutionLimit, 1);
+		myEnv.set(GRB_DoubleParam_Heuristics, 1);
+		myEnv.set(GRB_IntParam_RINS, 1);
+		myEnv.set(GRB_IntParam_ZeroObjNodes, 1);
+		myEnv.set(GRB_IntParam_PumpPasses, 1);
+
+		//Create tempNode to get a first ZInc from ovf formulation
+		Node *tempNode = new Node(cDualVars, eDualVars);
+		tempNode->setModel(model);
+		tempNode->setVHash(vHash);
+		tempNode->setCHash(cHash);
+
+		//The ovf formulation has no capacities, so with a load resource its solution may not be feasible
+		int s = tempNode->solve();
+		tempNode->printSolution();
+		if(tempNode->getZLP() < ZInc && !data->hasLoadResource()){
+			ZInc = tempNode->getZLP();
+			solutions.insert(tempNode->getSolution());
+		}
+		cout << "Solution status: " << s << " - ZInc = " << ZInc << endl;
+		delete tempNode;
+	}
+
+	//Disable gurobi output
+	myEnv.set(GRB_IntParam_OutputFlag,0);
+
+	//Build Explicit DWM model
+	buildDWM();
+
+	//Open nodes beyond the memory limit are stored on disk and rebuilt from the master without columns.
+	//Checkpoints use the same format
+	bool checkpointing = (parameters->getCheckpointFile() != "");
+	if(parameters->getNodeStoreMemory() > 0 || checkpointing){
+		nodeStore = new NodeStore(model, vHash, cHash, parameters->getTreeWorkers());
+		Node::setNodeStore(nodeStore);
+	}
+
+	//Robust cuts are kept in a pool shared by all the nodes (a resumed run reads it from the checkpoint)
+	cutPool = new CutPool();
+	if(parameters->getRootCutRounds() > 0 || parameters->getTreeCutRounds() > 0){
+		cutSeparator = new CutSeparator(data);
+	}
+	if(nodeStore != nullptr) nodeStore->setCutPool(cutPool);
+
+	strongBranchingTime = 0.0;
+	branchingsPerLevel = vector<int>(NUM_BRANCHING_LEVELS, 0);
+	closedPerLevel = vector<int>(NUM_BRANCHING_LEVELS, 0);
+	vector<Node*> openNodes;
+
+	if(resume){
+		if(!readCheckpoint(openNodes)){
+			cout << "Checkpoint " << parameters->getCheckpointFile() << " could not be read." << endl;
+			return GRB_INFEASIBLE;
+		}
+	}else{
+		Node *rootNode = new Node(cDualVars,eDualVars);
+		rootNode->setModel(model);
+		rootNode->setVHash(vHash);
+		rootNode->setCHash(cHash);
+
+		//Routes of the initial solution are the first columns of the master
+		vector<Route*>::iterator rit = initialRoutes.begin();
+		for(; rit != initialRoutes.end(); rit++){
+			(*rit)->setRouteNumber(routeCounter++);
+			rootNode->addColumn(*rit);
+			delete (*rit);
+		}
+		initialRoutes.clear();
+		openNodes.push_back(rootNode);
+	}
+
+	//At this point, root node has its own copy of the model
+	delete model;
+	vHash.clear();
+	cHash.clear();
+
+	//Workers for parallel evaluation of branching candidates and parallel tree search, created on first use
+	int numWorkers = parameters->getTreeWorkers();
+	workerEnvs = vector<GRBEnv*>(max(parameters->getNumThreads(), numWorkers), nullptr);
+	workerSolvers = vector<SubproblemSolver*>(workerEnvs.size(), nullptr);
+
+	//The first tree worker starts from the root node (resumed nodes are stored and rebuilt by any worker)
+	if(numWorkers > 1){
+		columnPool = new ColumnPool(parameters->getColumnPoolSize());
+		initWorker(0);
+		if(!resume) openNodes[0]->moveTo(workerEnvs[0], "root.mps");
+	}
+
+	//Solve DWM model by CG
+	tStart = clock();
+	lastCheckpoint = time(NULL);
+	status = BaP(openNodes);
+
+	return status;
+}
+
+void Solver::buildInitialModel(bool ovf)
+{
+	Job *job;
+	Equipment *e;
+	int tInit, tEnd;
+	int cont;
+	int contVars = 0;
+	int contCons = 0;
+
+	cout << "*******************" << endl;
+	cout << "Creating ovf model." << endl;
+	cout << "*******************" << endl;
+
+	//----------------
+	//CREATE VARIABLES
+	//----------------
+	Variable v, y, x, w;
+
+	cont = 0;
+	cout << "Creating y vars." << endl;
+	//yVars
+	for(int j=1; j < data->numJobs; j++){ //job 0 does not have an Y var
+		job = data->jobs[j];
+		tInit = job->getFirstStartTimePeriod();
+		tEnd = job->getLastStartTimePeriod();
+
+		for(int t=tInit; t <= tEnd; t++){
+			//Between work shifts
+			if(!job->isStartTimeFeasible(t)) continue;
+
+			y.reset();
+			y.setType(V_Y);
+			y.setStartJob(j);
+			y.setTime(t);
+
+			vHash[y] = true;
+			model->addVar(0.0,1.0,0.0,GRB_INTEGER,y.toString());
+			cont++;
+		}
+	}
+	cout << "Total y Vars created: " << cont << endl;
+	contVars += cont;
+
+	//xVars and wVars
+	int contw = 0;
+	cont = 0;
+	cout << "Creating x and w vars." << endl;
+	queue<Vertex*> myQueue;
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		e = data->equipments[eqType];
+
+		//Make a BFS over the problem network
+		Vertex *o, *d;
+		vector<vector<bool>> visited = vector<vector<bool>>(data->numJobs, vector<bool>(data->horizonLength+1,false));
+
+		o = data->problemNetwork.get(0, 0); //depot
+		myQueue.push(o);
+
+		while(myQueue.size() > 0){
+			o = myQueue.front();			
+			myQueue.pop();
+
+			int oJob = o->getJob();
+			int oTime = o->getTime();
+
+			int sourceReq = data->jobs[oJob]->getEquipmentTypeRequired(eqType);
+
+			if(!visited[oJob][oTime]){
+				visited[oJob][oTime] = true;
+
+				//Iterate through adjacence list for job o and eqType
+				vector<Vertex*>::iterator it = o->getAdjacenceList(eqType).begin();
+				vector<Vertex*>::iterator eit = o->getAdjacenceList(eqType).end();
+				for(; it != eit; it++){
+					d = (*it);
+					int dJob = d->getJob();
+					int dTime = d->getTime();
+
+					int destinationReq = data->jobs[dJob]->getEquipmentTypeRequired(eqType);
+					double transitionTime = e->getNotRoundedTransitionTime(oJob,dJob);
+
+					//CREATE VARS
+					if(oJob != dJob){ //not waiting					
+						//create xVar
+						x.reset();
+						x.setType(V_X);
+						x.setStartJob(o->getJob());
+						x.setEndJob(d->getJob());
+						x.setTime(o->getTime());
+						x.setArrivalTime(d->getTime());
+						x.setEquipmentTipe(eqType);
+
+						if(vHash.find(x) == vHash.end()){
+							vHash[x] = true;
+							model->addVar(0.0,1.0,transitionTime,GRB_INTEGER, x.toString());
+							cont++;
+						}					
+					}else if(ovf){
+						w.reset();
+						w.setType(V_W);
+						w.setStartJob(o->getJob());
+						w.setTime(o->getTime());
+						w.setEquipmentTipe(eqType);
+
+						if(vHash.find(w) == vHash.end()){
+							vHash[w] = true;
+							model->addVar(0.0,1.0,0.0,GRB_INTEGER,w.toString());
+							contw++;
+						}
+					}
+					myQueue.push(d);
+				}
+			}
+		}
+		visited.clear();
+	}
+	
+	contVars += cont + contw;
+
+	model->update();
+	cout << "Total x Vars created: " << cont << endl;
+	cout << "Total w Vars created: " << contw << endl;
+	cout << "Total Variables: " << contVars << endl;
+	//----------------------
+
+	//----------------------
+	//CREATE CONSTRAINTS
+	//----------------------
+	GRBVar var1, var2;
+	Constraint c1, c2;
+
+	cont = 0;
+	cout << "Creating cover constraints." << endl;
+	//Cover Constraints
+	for(int j=1; j < data->numJobs; j++){
+		GRBLinExpr expr = 0;
+
+		c1.reset();
+		c1.setType(C_COVER);
+		c1.setStartJob(j);
+
+		if(cHash.find(c1) == cHash.end()){
+			for(int t=0; t <= data->horizonLength; t++){
+				y.reset();
+				y.setType(V_Y);
+				y.setStartJob(j);
+				y.setTime(t);
+
+				if(vHash.find(y) != vHash.end()){
+					var1 = model->getVarByName(y.toString());
+					expr += var1;
+				}
+			}
+			cHash[c1] = true;
+			model->addConstr(expr == 1, c1.toString());
+			cont ++;
+		}
+	}
+	contCons += cont;
+	cout << "Total cover constraints created: " << cont << endl;
+
+	cout << "Creating synchronization constraints." << endl;
+	cont = 0;
+	//Synchronization Constraints
+	for(int j=1; j < data->numJobs; j++){
+		job = data->jobs[j];
+		tInit = job->getFirstStartTimePeriod();
+		tEnd = job->getLastStartTimePeriod();
+		for(int t=tInit; t <= tEnd; t++){
+			//Get y variable
+			y.reset();
+			y.setType(V_Y);
+			y.setStartJob(j);
+			y.setTime(t);
+
+			if(vHash.find(y) == vHash.end()) continue; //job cannot be attended at time period t, so go to t+1
+			var1 = model->getVarByName(y.toString());
+
+			for(int eqType=0; eqType < data->numEquipments; eqType++){
+				//Verify that job j requires eqType
+				if(job->getEquipmentTypeRequired(eqType) <= 0) continue;				
+
+				c1.reset();
+				c1.setType(C_SYNCH);
+				c1.setStartJob(j);
+				c1.setTime(t);
+				c1.setEquipmentType(eqType);
+
+				if(cHash.find(c1) == cHash.end()){
+					GRBLinExpr expr = 0;				
+					expr -= var1;
+
+					for(int i=0; i < data->numJobs; i++){
+						//Get x Variable
+						x.reset();
+						x.setType(V_X);
+						x.setStartJob(j);
+						x.setEndJob(i);
+						x.setTime(t);
+						x.setEquipmentTipe(eqType);
+
+						if(vHash.find(x) != vHash.end()){
+							var2 = model->getVarByName(x.toString());
+							expr += var2;
+						}
+					}
+
+					cHash[c1] = true;
+					model->addConstr(expr == 0, c1.toString());
+					cont ++;
+				}
+			}
+		}
+	}
+	contCons += cont;
+	cout << "Total synchronization constraints created: " << cont << endl;
+
+	cout << "Creating precedence constraints." << endl;
+	cont = 0;
+	//Precedence Constraints: job j can only have started by t if job i had started by t-delta. The time windows
+	//were tightened by the precedences, so rows are only needed while both jobs can still start
+	for(int i=1; i < data->numJobs; i++){
+		for(unsigned int p=0; p < data->successors[i].size(); p++){
+			int j = data->successors[i][p].first, delta;
+			data->getPrecedenceLag(i, j, delta);
+
+			for(int t=data->jobs[j]->getFirstStartTimePeriod(); t < data->jobs[i]->getLastStartTimePeriod() + delta; t++){
+				//Rows of the periods where j can not start are dominated by the previous one
+				if(!data->jobs[j]->isStartTimeFeasible(t)) continue;
+
+				c1.reset();
+				c1.setType(C_PRECEDENCE);
+				c1.setStartJob(i);
+				c1.setEndJob(j);
+				c1.setTime(t);
+
+				if(cHash.find(c1) != cHash.end()) continue;
+
+				GRBLinExpr expr = 0;
+				for(int tau=data->jobs[j]->getFirstStartTimePeriod(); tau <= t; tau++){
+					y.reset();
+					y.setType(V_Y);
+					y.setStartJob(j);
+					y.setTime(tau);
+					if(vHash.find(y) != vHash.end()) expr += model->getVarByName(y.toString());
+				}
+				for(int tau=data->jobs[i]->getFirstStartTimePeriod(); tau <= t - delta; tau++){
+					y.reset();
+					y.setType(V_Y);
+					y.setStartJob(i);
+					y.setTime(tau);
+					if(vHash.find(y) != vHash.end()) expr -= model->getVarByName(y.toString());
+				}
+
+				cHash[c1] = true;
+				model->addConstr(expr <= 0, c1.toString());
+				cont ++;
+			}
+		}
+	}
+	contCons += cont;
+	cout << "Total precedence constraints created: " << cont << endl;
+
+	//Flow constraints are only needed to solve the ovf formulation
+	if(!ovf){
+		cout << "Total constraints in OVF: " << contCons << endl;
+		model->update();
+		return;
+	}
+
+	cont = 0;
+	cout << "Creating flow init constraints." << endl;
+	//Fow Init constraints
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		e = data->equipments[eqType];
+		
+		c1.reset();
+		c1.setType(C_OVF_FLOW_INIT);
+		c1.setEquipmentType(eqType);
+
+		if(cHash.find(c1) != cHash.end()) continue;
+
+		GRBLinExpr expr = 0;
+
+		for(int j=1; j < data->numJobs; j++){
+			x.reset();
+			x.setType(V_X);
+			x.setStartJob(0);
+			x.setEndJob(j);
+			x.setTime(0);
+			x.setEquipmentTipe(eqType);
+
+			if(vHash.find(x) != vHash.end()){
+				var1 = model->getVarByName(x.toString());
+				expr += var1;				
+			}
+		}
+
+		//Machines waiting at the depot for the next work shift
+		w.reset();
+		w.setType(V_W);
+		w.setStartJob(0);
+		w.setTime(0);
+		w.setEquipmentTipe(eqType);
+		if(vHash.find(w) != vHash.end()){
+			var1 = model->getVarByName(w.toString());
+			expr += var1;
+		}
+
+		cHash[c1] = true;
+		model->addConstr(expr == e->getNumMachines(), c1.toString());
+		cont ++;
+	}
+	contCons += cont;
+	cout << "Total flow init constraints created: " << cont << endl;
+
+	cont = 0;
+	cout << "Creating flow constraints." << endl;
+	vector<Vertex*>::iterator it, eit;
+	//Create Flow constraints
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		e = data->equipments[eqType];
+		for(int j=0; j<data->numJobs; j++){
+			job = data->jobs[j];
+
+			if(j != 0 && job->getEquipmentTypeRequired(eqType) <= 0) continue;
+
+			tInit = min(job->getFirstStartTimePeriod(),(int)e->getTransitionTime(0,j));
+			tEnd = job->getLastStartTimePeriod();
+
+			//The depot only has vertices inside the horizon at the start of the work shifts
+			if(j == 0){
+				tInit = 1;
+				tEnd = data->horizonLength - 1;
+			}
+
+			for(int t = tInit; t <= tEnd; t++){
+				//No vertex between work shifts
+				if(data->problemNetwork.get(j, t) == nullptr) continue;
+
+				c1.reset();
+				c1.setType(C_OVF_FLOW);
+				c1.setStartJob(j);
+				c1.setTime(t);
+				c1.setEquipmentType(eqType);
+
+				if(cHash.find(c1) == cHash.end()){
+					GRBLinExpr expr = 0;
+
+					//Leaving variables (+)
+					it = data->problemNetwork.get(j, t)->getAdjacenceList(eqType).begin();
+					eit = data->problemNetwork.get(j, t)->getAdjacenceList(eqType).end();
+
+					for(; it != eit; it++){
+						int i = (*it)->getJob();
+						
+						if(i != j){ //transition
+							//Get x variable
+							v.reset();
+							v.setType(V_X);
+							v.setStartJob(j);
+							v.setEndJob(i);
+							v.setTime(t);
+							v.setEquipmentTipe(eqType);
+
+							if(vHash.find(v) != vHash.end()){
+								var1 = model->getVarByName(v.toString());
+								expr += var1;
+							}
+						}else{ //waiting
+							//Get w variable
+							v.reset();
+							v.setType(V_W);
+							v.setStartJob(j);
+							v.setTime(t);
+							v.setEquipmentTipe(eqType);
+
+							if(vHash.find(v) != vHash.end()){
+								var1 = model->getVarByName(v.toString());
+								expr += var1;
+							}
+						}
+					}
+
+					//Entering variaveis (-)
+					it = data->problemNetwork.get(j, t)->getIncidenceList(eqType).begin();
+					eit = data->problemNetwork.get(j, t)->getIncidenceList(eqType).end();
+
+					for(; it != eit; it++){
+						int i = (*it)->getJob();
+						int t1 = (*it)->getTime();
+
+						if(i != j){ //Transition
+							//Get x variable
+							v.reset();
+							v.setType(V_X);
+							v.setStartJob(i);
+							v.setEndJob(j);
+							v.setTime(t1);
+							v.setEquipmentTipe(eqType);
+
+							if(vHash.find(v) != vHash.end()){
+								var1 = model->getVarByName(v.toString());
+								expr -= var1;
+							}
+						}else{ //Waiting
+							//Get w Variable
+							v.reset();
+							v.setType(V_W);
+							v.setStartJob(j);
+							v.setTime(t1);
+							v.setEquipmentTipe(eqType);
+
+							if(vHash.find(v) != vHash.end()){
+								var1 = model->getVarByName(v.toString());
+								expr -= var1;
+							}
+						}
+					}
+
+					cHash[c1] = true;
+					model->addConstr(expr == 0, c1.toString());
+					cont ++; 
+				}
+			}
+		}
+	}
+	contCons += cont;
+	cout << "Total flow constraints created: " << cont << endl;
+	cout << "Total constraints in OVF: " << contCons << endl;
+
+	model->update();
+	//----------------------
+	
+	model->write("modelo_OVF.lp");
+}
+
+void Solver::buildDWM()
+{		
+	int cont;
+	int contVars = 0;
+	int contCons = 0;
+
+	GRBVar var1, var2;
+	GRBConstr cons;
+
+	Constraint c;
+	Variable v, b, f;
+
+	cout << "****************************" << endl;
+	cout << "Creating explicit dwm model." << endl;
+	cout << "****************************" << endl;
+
+	//Relax integer variables
+	
+	cout << "Deleting w (ovf) variables, relaxing y and x variaveis." << endl;
+	//Delete w variables
+	VariableHash::iterator vit = vHash.begin();
+	while(vit != vHash.end()){
+		v = vit->first;
+		var1 = model->getVarByName(v.toString());
+
+		if(v.getType() == V_W){ 
+			model->remove(var1);
+			vHash.erase(vit++);
+		}else{
+			if(v.getType() == V_X){
+				//Relax integer x variable
+				var1.set(GRB_CharAttr_VType, GRB_CONTINUOUS);				
+			}else if(v.getType() == V_Y){
+				//Relax integer variable
+				var1.set(GRB_CharAttr_VType, GRB_CONTINUOUS);
+			}
+			vit++;
+		}
+	}
+
+	cont = 0;
+	cout << "Creating b auxilaty variables." << endl;
+	//Create bAux vars
+	for(int i=0; i< data->numJobs; i++){
+		for(int j=0; j<data->numJobs; j++){
+			for(int t=0; t < data->horizonLength; t++){
+				for(int eqType = 0; eqType < data->numEquipments; eqType++){
+					v.reset();
+					v.setType(V_X);
+					v.setStartJob(i);
+					v.setEndJob(j);
+					v.setTime(t);
+					v.setEquipmentTipe(eqType);
+
+					if(vHash.find(v) == vHash.end()) continue;
+
+					b.reset();
+					b.setType(V_BAUX);
+					b.setStartJob(i);
+					b.setEndJob(j);
+					b.setTime(t);
+					b.setEquipmentTipe(eqType);
+
+					if(vHash.find(b) == vHash.end()){
+						vHash[b] = true;
+						model->addVar(0.0,1.0,bigM,GRB_CONTINUOUS,b.toString());
+						cont ++;
+					}
+				}
+			}
+		}
+	}
+	contVars += cont;
+	cout << "Total b aux variables created: " << cont << endl;
+	
+	cont = 0;
+	cout << "Creating f auxiliary variables." << endl;
+	//fAuxVar
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		Equipment *e = data->equipments[eqType];
+
+		f.reset();
+		f.setType(V_FAUX);
+		f.setEquipmentTipe(eqType);
+
+		vHash[f] = true;
+		model->addVar(0.0,e->getNumMachines(),bigM,GRB_CONTINUOUS, f.toString());
+		cont ++;
+	}
+	contVars += cont;
+	cout << "Total f aux variables created: " << cont << endl;
+	cout << "Total auxiliary variables created in dwm: " << contVars << endl;
+
+	model->update();
+	//----------------------
+
+	//-----------------------------
+	//ERASE SUBPROBLEM CONSTRAINTS
+	//-----------------------------	
+	cout << "Erasing subproblem constraints (flow)." << endl;
+	ConstraintHash::iterator cit = cHash.begin();
+
+	while(cit != cHash.end()){
+		c = cit->first;
+
+		if(c.getType() == C_OVF_FLOW || c.getType() == C_OVF_FLOW_INIT){
+			cons = model->getConstrByName(c.toString());
+			cHash.erase(cit++);
+			model->remove(cons);
+		}else{
+			cit++;
+		}
+	}
+	model->update();
+	//----------------------
+
+	//----------------------
+	//CREATE CONSTRAINTS
+	//----------------------
+	cont = 0;
+	cout << "Creating route number constraints." << endl;
+	//Cardinality constraints
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		Equipment *e = data->equipments[eqType];
+		
+		GRBLinExpr expr = 0;
+
+		c.reset();
+		c.setType(C_CARD);
+		c.setEquipmentType(eqType);
+		c.setId(cont);
+
+		f.reset();
+		f.setType(V_FAUX);
+		f.setEquipmentTipe(eqType);
+
+		if(cHash.find(c) == cHash.end() && vHash.find(f) != vHash.end()){
+			var1 = model->getVarByName(f.toString());
+			expr += var1;
+			cHash[c] = true;
+			model->addConstr(expr == e->getNumMachines(), c.toString());
+			cont++;
+		}
+	}
+	cDualVars = cont;
+	contCons += cont;
+	cout << "Convex constraints created: " << cont << endl;
+	
+	cont = 0;
+	cout << "Creating explicit master constraints." << endl;
+	//Explicit master constraints
+	for(int i=0; i < data->numJobs; i++){
+		Job *iJob = data->jobs[i];
+		//The depot leaves at the start of every work shift
+		int tFirst = (i == 0)? 0 : iJob->getFirstStartTimePeriod();
+		int tLast = (i == 0)? data->getShiftStart(data->horizonLength - 1) : iJob->getLastStartTimePeriod();
+		for(int j=0; j < data->numJobs; j++){
+			for(int t=tFirst; t <= tLast; t++){
+				for(int eqType=0; eqType < data->numEquipments; eqType++){
+					GRBLinExpr expr = 0;
+
+					c.reset();
+					c.setType(C_EXPLICIT);
+					c.setStartJob(i);
+					c.setEndJob(j);
+					c.setTime(t);
+					c.setEquipmentType(eqType);
+					c.setId(cont);
+
+					v.reset();
+					v.setType(V_X);
+					v.setStartJob(i);
+					v.setEndJob(j);
+					v.setTime(t);
+					v.setEquipmentTipe(eqType);
+
+					b.reset();
+					b.setType(V_BAUX);
+					b.setStartJob(i);
+					b.setEndJob(j);
+					b.setTime(t);
+					b.setEquipmentTipe(eqType);
+
+					if(cHash.find(c) == cHash.end() && vHash.find(v) != vHash.end() && vHash.find(b) != vHash.end()){
+						var1 = model->getVarByName(v.toString());
+						var2 = model->getVarByName(b.toString());
+						expr += var1;
+						expr -= var2;
+						cHash[c] = true;
+						model->addConstr(expr == 0, c.toString());
+						cont ++;
+					}
+
+				}
+			}
+		}
+	}
+	eDualVars = cont;
+	contCons += cont;
+	cout << "Total explicit master constraints: " << cont << endl;
+	cout << "Total constraints specific to the DWM: " << cont << endl;
+
+	model->update();
+	//----------------------
+
+	model->write("modelo_EDWM.lp");
+}
+
+int Solver::getFeasibleSolution()
+{
+	cout << "*********************************" << endl;
+	cout << "Running constructive heuristic." << endl;
+	cout << "*********************************" << endl;
+
+	ConstructiveHeuristic heuristic(data);
+	if(!heuristic.solve()){
+		cout << "Constructive heuristic could not find a feasible solution." << endl;
+		return GRB_INFEASIBLE;
+	}
+
+	ZInc = heuristic.getSolutionValue();
+	Solution *s = heuristic.getSolution();
+	if(!solutions.insert(s).second) delete s; //a solution with the same value is already stored
+	initialRoutes = heuristic.getRoutes();
+
+	cout << "Constructive heuristic ZInc = " << ZInc << endl;
+	return GRB_OPTIMAL;
+}
+
+int Solver::restrictedMasterHeuristic(Node *node)
+{
+	string sep = "-------------------------------------------------------------------";
+	cout << sep << endl;
+	cout << "Solving restricted master MIP on node " << node->getNodeId() << " (" << node->getRouteCount() << " routes)." << endl;
+
+	//Work on a copy, the node keeps its linear relaxation
+	Node *mipNode = new Node(*node);
+	int status = mipNode->solveRestrictedMIP(parameters->getRMPHeuristicTimeLimit(), getIncumbent() - parameters->getEpsilon());
+
+	//Any solution found by the MIP is feasible, its values were rounded by solveRestrictedMIP
+	if(mipNode->getSolutionCount() > 0){
+		if(mipNode->isIntegerSolution() && updateIncumbent(mipNode, "BY RESTRICTED MASTER")){
+			status = GRB_OPTIMAL;
+		}
+	}else{
+		cout << "No improving solution found. Status: " << status << endl;
+	}
+
+	cout << "ZInc = " << getIncumbent() << endl;
+	cout << sep << endl;
+
+	delete mipNode;
+	return status;
+}
+
+int Solver::priceAndDive(Node *node, SubproblemSolver *subproblem)
+{
+	int status;
+	int fixings = 0;
+	int backtracks = 0;
+	Variable lastFixed;
+
+	string sep = "-------------------------------------------------------------------";
+	cout << sep << endl;
+	cout << "Starting price and dive from node " << node->getNodeId() << endl;
+	cout << sep << endl;
+
+	//The dive works on copies, only the last fixing can be undone
+	Node *diveNode = new Node(*node);
+	Node *lastNode = nullptr;
+	diveNode->setNodeId(node->getNodeId());
+
+	while(true){
+		status = solveLPByColumnGeneration(diveNode, 0, 0, subproblem);
+
+		if(status != GRB_OPTIMAL || diveNode->getZLP() >= getIncumbent() - parameters->getEpsilon()){
+			if(lastNode == nullptr || backtracks >= parameters->getDivingMaxBacktracks()){
+				cout << "Dive abandoned after " << fixings << " fixings and " << backtracks << " backtracks." << endl;
+				break;
+			}
+
+			//Backtrack: forbid the last fixed variable instead. Pricing would generate a route fixed to 0 again,
+			//so for a lambda one of its arcs is removed from the network
+			if(lastFixed.getType() == V_LAMBDA) lastFixed = lastNode->getRouteArc(lastFixed);
+			if(lastFixed.getType() == V_ERROR){
+				cout << "Dive abandoned after " << fixings << " fixings and " << backtracks << " backtracks." << endl;
+				break;
+			}
+
+			cout << "Dive backtracking on variable: " << lastFixed.toString() << endl;
+			delete diveNode;
+			diveNode = lastNode;
+			lastNode = nullptr;
+			diveNode->addBranchConstraint(lastFixed, 0.0);
+			backtracks++;
+			continue;
+		}
+
+		if(diveNode->isIntegerSolution()){
+			updateIncumbent(diveNode, "BY DIVING");
+			break;
+		}
+
+		lastFixed = diveNode->getDivingCandidate();
+		if(lastFixed.getType() == V_ERROR) break;
+
+		delete lastNode;
+		lastNode = new Node(*diveNode);
+		lastNode->setNodeId(node->getNodeId());
+
+		cout << "Dive fixing variable: " << lastFixed.toString() << " = " << lastFixed.getValue() << endl;
+		diveNode->addBranchConstraint(lastFixed, 1.0);
+		fixings++;
+	}
+
+	delete diveNode;
+	delete lastNode;
+	return status;
+}
+
+bool Solver::solveByEnumeration(Node *node, SubproblemSolver *subproblem)
+{
+	double eps = parameters->getEpsilon();
+	double incumbent = getIncumbent();
+	double gap = incumbent - node->getZLP();
+	if(incumbent >= 1e13 || 100.0 * gap / max(incumbent, eps) > parameters->getEnumerationGap()) return false;
+
+	string sep = "-------------------------------------------------------------------";
+	cout << sep << endl;
+	cout << "Enumerating routes with reduced cost below the gap " << gap << " on node " << node->getNodeId() << endl;
+
+	//Only routes with reduced cost below the gap can be part of an improving solution
+	vector<Route*> enumerated;
+	bool complete = true;
+	int maxRoutes = parameters->getMaxEnumeratedRoutes();
+	for(int eqType=0; eqType < data->numEquipments && complete; eqType++){
+		complete = subproblem->enumerate(node, eqType, gap, maxRoutes - enumerated.size());
+		enumerated.insert(enumerated.end(), subproblem->routes.begin(), subproblem->routes.end());
+		subproblem->routes.clear();
+	}
+
+	vector<Route*>::iterator rit;
+	if(!complete){
+		cout << "Enumeration stopped at " << maxRoutes << " routes, branching instead." << endl;
+		cout << sep << endl;
+		for(rit = enumerated.begin(); rit != enumerated.end(); rit++) delete (*rit);
+		return false;
+	}
+
+	//Set partitioning MIP over the enumerated routes on a copy of the node
+	Node *mipNode = new Node(*node);
+	for(rit = enumerated.begin(); rit != enumerated.end(); rit++){
+		#pragma omp critical(routeCounter)
+		(*rit)->setRouteNumber(routeCounter++);
+		mipNode->addColumn(*rit);
+		delete (*rit);
+	}
+	cout << enumerated.size() << " routes enumerated. Solving the set partitioning MIP." << endl;
+
+	int status = mipNode->solveRestrictedMIP(parameters->getEnumerationTimeLimit(), incumbent - eps);
+
+	//Any solution found improves the incumbent (its values were rounded by solveRestrictedMIP).
+	//Without time limit the MIP is exact: either it improves the incumbent or the incumbent is optimal in this node
+	if(mipNode->getSolutionCount() > 0) updateIncumbent(mipNode, "BY ENUMERATION");
+	bool solved = (status == GRB_OPTIMAL || status == GRB_INFEASIBLE);
+
+	cout << "Enumeration " << (solved? "closed" : "did not close") << " node " << node->getNodeId() << ". Status: " << status << endl;
+	cout << "ZInc = " << getIncumbent() << endl;
+	cout << sep << endl;
+
+	delete mipNode;
+	return solved;
+}
+
+const Variable Solver::getBranchingVariable(Node *node, int worker)
+{
+	int numCandidates = parameters->getStrongBranchingCandidates();
+	int threshold = parameters->getReliabilityThreshold();
+	Variable v;
+	vector<Variable> candidates;
+
+	//First level of the hierarchy with fractional candidates
+	string hierarchy = parameters->getBranchingHierarchy();
+	for(unsigned int i=0; i < hierarchy.size() && candidates.size() == 0; i++){
+		switch(hierarchy[i]){
+			case 'm': candidates = node->getBranchingCandidates(BRANCH_MACHINES); break;
+			case 'f': candidates = node->getBranchingCandidates(BRANCH_FLOW); break;
+			case 't': candidates = node->getBranchingCandidates(BRANCH_TIME_WINDOW); break;
+			case 'a': candidates = node->getBranchingCandidates(BRANCH_ARC); break;
+		}
+	}
+
+	if(candidates.size() == 0){
+		cout << "ATENTION: No fractional variable found!!! Still not integer solution????" << endl;
+		return v;
+	}
+
+	//Rank candidates by pseudo cost score
+	for(unsigned int k=0; k < candidates.size(); k++){
+		candidates[k].setScore(pseudoCosts.getScore(candidates[k]));
+	}
+	VariableScoreComparator comp;
+	sort(candidates.rbegin(), candidates.rend(), comp);
+
+	//Unreliable candidates among the best ones are evaluated by strong branching
+	vector<Variable> unreliable = vector<Variable>();
+	for(unsigned int k=0; k < candidates.size() && (int)unreliable.size() < numCandidates; k++){
+		if(!pseudoCosts.isReliable(candidates[k], threshold)){
+			unreliable.push_back(candidates[k]);
+		}
+	}
+
+	if(unreliable.size() > 0 && parameters->getStrongBranchingIterations() > 0){
+		vector<double> delta = strongBranching(node, unreliable, worker);
+
+		for(unsigned int k=0; k < unreliable.size(); k++){
+			//Strong branching results are also pseudo cost observations
+			if(delta[2*k] < bigM) pseudoCosts.update(unreliable[k], 0.0, delta[2*k]);
+			if(delta[2*k + 1] < bigM) pseudoCosts.update(unreliable[k], 1.0, delta[2*k + 1]);
+
+			double score = PseudoCostStore::getScore(delta[2*k], delta[2*k + 1]);
+			cout << "Strong branching candidate " << unreliable[k].toString() << ": " << delta[2*k] << " x " << delta[2*k + 1] << " = " << score << endl;
+			if(score > candidates[0].getScore()){
+				unreliable[k].setScore(score);
+				candidates[0] = unreliable[k];
+			}
+		}
+	}
+
+	return candidates[0];
+}
+
+vector<double> Solver::strongBranching(Node *node, const vector<Variable> &candidates, int worker)
+{
+	clock_t sbStart = clock();
+	int numCandidates = candidates.size();
+	int maxIterations = parameters->getStrongBranchingIterations();
+	double parentZlp = node->getZLP();
+
+	//Models can not be shared between enviroments, so workers read the node model from a file
+	string modelFile = "strong_" + itos(node->getNodeId()) + ".mps";
+	node->getModel()->write(modelFile);
+
+	//Bound change of each child (candidate k: 2k is the 0 branch, 2k+1 is the 1 branch)
+	vector<double> delta = vector<double>(2 * numCandidates, 0.0);
+
+	//Inside a tree worker the candidates are evaluated sequentially in its own enviroment
+	bool sequential = (worker >= 0);
+
+	#pragma omp parallel for num_threads(parameters->getNumThreads()) schedule(dynamic) if(!sequential)
+	for(int k=0; k < 2 * numCandidates; k++){
+		int w = sequential? worker : omp_get_thread_num();
+		initWorker(w);
+		Node *child = new Node(*node, workerEnvs[w], modelFile);
+		child->addBranchConstraint(candidates[k / 2], k % 2);
+
+		int status = solveLPByColumnGeneration(child, 0, maxIterations, workerSolvers[w]);
+		if(status == GRB_OPTIMAL){
+			delta[k] = max(child->getZLP() - parentZlp, 0.0);
+		}else{
+			delta[k] = bigM; //an infeasible child is the best possible outcome
+		}
+		delete child;
+	}
+	remove(modelFile.c_str());
+
+	double elapsed = (double)(clock() - sbStart)/CLOCKS_PER_SEC;
+	#pragma omp atomic
+	strongBranchingTime += elapsed;
+	return delta;
+}
+
+int Solver::pruneOpenNodes(NodePool &openNodes, int worker)
+{
+	double incumbent = getIncumbent();
+
+	int pruned = openNodes.pruneByBound(worker, incumbent);
+	if(pruned > 0){
+		cout << pruned << " open nodes pruned by the incumbent " << incumbent << endl;
+	}
+	return pruned;
+}
+
+void Solver::closeNode(Node *node)
+{
+	//Statistics: level of the branching that closed the node
+	if(node->getBranchVariable().getType() != V_ERROR){
+		#pragma omp atomic
+		closedPerLevel[Node::getBranchingLevel(node->getBranchVariable())]++;
+	}
+}
+
+double Solver::getIncumbent()
+{
+	double value;
+
+	//Shared by the workers of the parallel tree search
+	#pragma omp critical(incumbent)
+	value = ZInc;
+
+	return value;
+}
+
+bool Solver::updateIncumbent(Node *node, const string &origin)
+{
+	bool improved = false;
+	string sep = "-------------------------------------------------------------------";
+
+	#pragma omp critical(incumbent)
+	{
+		if(node->getZLP() < ZInc - parameters->getEpsilon() || solutions.size() == 0){
+			Solution *s = node->getSolution();
+
+			cout << sep << endl;
+			cout << "NEW INCUMBENT FOUND " << origin << ": " << endl;
+			cout << s->toString() << endl;
+			cout << sep << endl;
+
+			solutions.insert(s);
+			ZInc = node->getZLP();
+			improved = true;
+		}
+	}
+
+	return improved;
+}
+
+int Solver::solveLPByColumnGeneration(Node *node, int treeSize, int maxIterations, SubproblemSolver *subproblem)
+{
+	int status = GRB_INPROGRESS;
+	double Zlp = 1e13;
+	double lagrangeanBound = 0.0;
+	int fixatedVars;
+	int totalFixatedVars = 0;
+	int rCount;
+	int totalRoutes = 0;
+	double minRouteCost = 0.0;
+	int iteration = 0;
+
+	//Truncated runs (strong branching) are quiet and may use a worker subproblem solver
+	bool verbose = (maxIterations == 0);
+	if(subproblem == nullptr) subproblem = spSolver;
+
+	//Reset subproblem solver
+	subproblem->reset();
+	Route *myRoute;
+	vector<Route*> generatedRoutes = vector<Route*>();
+	vector<Route*>::iterator rit, eit;
+
+	//Routes of the shared pool are used until they do not price out
+	bool usePool = (columnPool != nullptr);
+
+	//Cut rounds once the LP is solved by column generation (the bound gained at the root is credited to the family of each round)
+	int cutRounds = 0;
+	if(verbose && cutSeparator != nullptr){
+		cutRounds = (node->getDepth() == 0)? parameters->getRootCutRounds() : parameters->getTreeCutRounds();
+	}
+	vector<int> cutsByFamily = vector<int>(NUM_CUT_FAMILIES, 0);
+	CutFamily cutFamily = NUM_CUT_FAMILIES;
+	double cutZlp = 0.0;
+	bool cutsAged = false;
+
+	//Apply the branching decisions to the pricing network before solving any LP
+	if(!subproblem->propagateBranching(node)){
+		if(verbose) cout << "Node " << node->getNodeId() << " INFEASIBLE by propagation of branching decisions." << endl;
+		return GRB_INFEASIBLE;
+	}
+
+	//Dynamically solve the model by column generation.
+	bool end = false;
+	while(!end){
+		stringstream output;
+
+		//Solve current model
+		iteration ++;
+		status = node->solve();	
+
+		if(status == GRB_OPTIMAL){
+			int sw = 0;		
+			
+			rCount = 0;
+			fixatedVars = 0;
+			double Zlp = node->getZLP();
+			double incumbent = getIncumbent();
+			lagrangeanBound = incumbent - Zlp;
+
+			bool poolRound = false;
+			if(usePool){
+				poolRound = (columnPool->getImprovingRoutes(node, subproblem, generatedRoutes, parameters->getMaxRoutes()) > 0);
+				usePool = poolRound;
+			}
+
+			//Generate routes for each equipment type
+			for(int eqType = 0; eqType < data->numEquipments && !poolRound; eqType++){
+				Equipment *e = data->equipments[eqType];					
+				minRouteCost = 0.0;
+				
+				subproblem->solve(node, eqType, 10);
+				if(subproblem->isInfeasible()){
+					return GRB_INFEASIBLE;
+				}
+
+				//Verify that at least 1 route was generated
+				if(subproblem->routes.size() == 0) continue;
+
+				//Append routes to generated routes vector
+				minRouteCost = subproblem->routes[0]->getCost();
+				generatedRoutes.insert(generatedRoutes.end(),subproblem->routes.begin(),subproblem->routes.end());
+				if(columnPool != nullptr){
+					for(rit = subproblem->routes.begin(); rit != subproblem->routes.end(); rit++) columnPool->add(*rit);
+				}
+				lagrangeanBound -= (e->getNumMachines() * minRouteCost);
+			}
+
+			//If no routes where generated, the current lp solution is optimal
+			if(generatedRoutes.size() == 0){
+				if(parameters->useDualStabilization()){
+					if(node->getMaxPiDifference() <= parameters->getEpsilon()){
+						end = true;
+					}else{
+						cout << "No route found. Updating Pi" << endl;
+						node->updatePi();
+						continue;
+					}
+				}else{
+					end = true;
+				}
+			}else{
+				//fix variables by reduced cost using the lagrangean bound (only valid with exact duals and full pricing)
+				if(iteration % 10 == 0 && incumbent < 1e13 && !poolRound && !parameters->useDualStabilization()){
+					fixatedVars = node->fixVarsByReducedCost(lagrangeanBound);
+					totalFixatedVars += fixatedVars;
+
+					//Shrink the pricing network
+					if(fixatedVars > 0 && !subproblem->propagateBranching(node)){
+						if(verbose) cout << "Node " << node->getNodeId() << " INFEASIBLE by reduced cost fixing." << endl;
+						for(rit = generatedRoutes.begin(); rit != generatedRoutes.end(); rit++) delete (*rit);
+						return GRB_INFEASIBLE;
+					}
+				}
+
+				//Add routes to the model
+				rit = generatedRoutes.begin();
+				eit = generatedRoutes.end();
+				for(; rit != eit; rit++){
+					myRoute = (*rit);
+					#pragma omp critical(routeCounter)
+					myRoute->setRouteNumber(routeCounter++);
+					//cout << myRoute->toString() << endl;
+					if(!node->addColumn(myRoute)){
+						cout << "Error: column " << myRoute->getRouteNumber() << "," 
+							<< myRoute->getEquipmentType() << " already existed in node " << node->getNodeId() << endl;
+					}
+					delete myRoute;
+					rCount ++;
+					totalRoutes ++;
+				}					
+				generatedRoutes.clear();
+			}
+
+			//Separate cuts on the solved LP, column generation goes on while they are added or dropped
+			if(end && (cutRounds > 0 || node->getCuts().size() > 0) && verbose && cutSeparator != nullptr){
+				if(node->getDepth() == 0){
+					if(cutFamily == NUM_CUT_FAMILIES) cutPool->setRootBound(node->getZLP());
+					else cutPool->addRootGain(cutFamily, node->getZLP() - cutZlp);
+				}
+				cutFamily = NUM_CUT_FAMILIES;
+
+				//Cuts age once per round (once per node without rounds)
+				int dropped = (cutRounds > 0 || !cutsAged)? node->ageCuts(parameters->getCutMaxAge()) : 0;
+				cutsAged = true;
+				int added = 0;
+				if(cutRounds > 0){
+					cutRounds--;
+					cutZlp = node->getZLP();
+					added = separateCuts(node, cutFamily);
+					if(added > 0) cutsByFamily[cutFamily] += added;
+				}
+				if(added > 0 || dropped > 0){
+					cout << "Node " << node->getNodeId() << ": " << added << " cuts added, " << dropped << " cuts dropped." << endl;
+					end = false;
+				}
+			}
+
+			//Truncated column generation
+			if(!verbose && iteration >= maxIterations) end = true;
+
+			if(verbose && (iteration % 5 == 0 || end)){
+				output << left;
+				output << "| " << "Id: " << setw(4) << node->getNodeId() << " Unexp: " << setw(4) << treeSize << " Iter: " << setw(5) << iteration;
+				output << "| " << "Zlp: " << setw(7) << Zlp << " ZInc: " << setw(7) << incumbent;
+				output << "| " << "Routes: " << setw(5) << rCount << "Total: " << setw(5) << totalRoutes << " MinRC: " << setw(10) << minRouteCost;
+				output << "| " << "LagBound: " << setw(10) << lagrangeanBound << " Fix: " << setw(4) << fixatedVars << " TFix: " << setw(5) << totalFixatedVars;
+				output << "| " << "Time: " << setw(5)  << (double)(clock() - tStart)/CLOCKS_PER_SEC << "s | ";
+
+				cout << output.str() << endl;
+			}
+		}else{ //INFEASIBLE
+			if(verbose){
+				node->getModel()->write("modelo_inf.lp");
+				cout << "Infeasible" << endl;
+			}
+			return GRB_INFEASIBLE;
+		}
+	}
+
+	for(int f=0; f < NUM_CUT_FAMILIES; f++){
+		if(cutsByFamily[f] > 0) cutPool->addNodeStatistics((CutFamily)f, cutsByFamily[f]);
+	}
+
+	//node->printSolution();
+	return status;
+}
+
+int Solver::separateCuts(Node *node, CutFamily &family)
+{
+	vector<vector<vector<double>>> flows = node->getArcFlows();
+	int maxCuts = parameters->getMaxCutsPerRound();
+	vector<Cut*> violated;
+
+	//Robust cuts of the pool first, then new cuts of one family at a time (capacity, tournament, subset row)
+	if(cutPool->getViolatedCuts(node, flows, violated, maxCuts) > 0){
+		family = violated[0]->getFamily();
+		for(unsigned int k=0; k < violated.size(); k++){
+			node->addCut(violated[k]);
+		}
+		return violated.size();
+	}
+
+	if(cutSeparator->separateCapacityCuts(flows, violated, maxCuts) > 0){
+		family = CUT_CAPACITY;
+	}else if(cutSeparator->separateTournamentCuts(flows, violated, maxCuts) > 0){
+		family = CUT_TOURNAMENT;
+	}else{
+		//Each subset row cut adds a state to the labels, so their number per equipment type is limited
+		for(int eqType=0; eqType < data->numEquipments && (int)violated.size() < maxCuts; eqType++){
+			int available = parameters->getMaxSubsetRowCuts() - node->getSubsetRowCuts(eqType).size();
+			if(available <= 0) continue;
+
+			vector<pair<double,vector<int>>> routes = node->getRouteSolution(eqType);
+			cutSeparator->separateSubsetRowCuts(eqType, routes, violated, min(available, maxCuts - (int)violated.size()));
+		}
+		if(violated.size() > 0) family = CUT_SUBSET_ROW;
+	}
+
+	int added = 0;
+	for(unsigned int k=0; k < violated.size(); k++){
+		//A cut already in the pool may have been dropped by this node
+		int id = cutPool->add(violated[k]);
+		if(node->hasCut(id)) continue;
+		node->addCut(cutPool->getCut(id));
+		added++;
+	}
+	return added;
+}
+
+void Solver::initWorker(int w)
+{
+	//Every slot is only used by its own thread, the creation is serialized for Gurobi.
+	//Tree workers split the threads between their enviroments so the machine is not oversubscribed
+	#pragma omp critical(workerInit)
+	if(workerEnvs[w] == nullptr){
+		int numWorkers = parameters->getTreeWorkers();
+		GRBEnv *workerEnv = new GRBEnv();
+		workerEnv->set(GRB_IntParam_OutputFlag, 0);
+		workerEnv->set(GRB_IntParam_Threads, (numWorkers > 1)? max(1, parameters->getNumThreads() / numWorkers) : 1);
+		workerSolvers[w] = new SubproblemSolver(data, QROUTE_NOLOOP);
+		workerEnvs[w] = workerEnv;
+	}
+}
+
+int Solver::BaP(const vector<Node*> &nodes)
+{	
+	int numWorkers = parameters->getTreeWorkers();
+
+	NodePool openNodes(numWorkers, (NodeSelection)parameters->getNodeSelection());
+	openNodes.setNodeStore(nodeStore, parameters->getNodeStoreMemory());
+	for(unsigned int i=0; i < nodes.size(); i++){
+		openNodes.push(0, nodes[i]);
+	}
+
+	string sep = "-------------------------------------------------------------------";
+	cout << sep << endl;
+	cout << "Starting branch and price algorithm with " << numWorkers << " workers and " << nodes.size() << " open nodes. Initial Incumbent: " << ZInc << endl;
+	cout << sep << endl;
+
+	if(numWorkers > 1){
+		#pragma omp parallel num_threads(numWorkers)
+		searchTree(omp_get_thread_num(), openNodes);
+	}else{
+		searchTree(0, openNodes);
+	}
+
+	cout << sep << endl;
+	cout << "Explored nodes: " << exploredNodes << " - Total time: " << (double)(clock() - tStart)/CLOCKS_PER_SEC << "s";
+	cout << " - Strong branching time: " << strongBranchingTime << "s" << endl;
+	double pricingTime = spSolver->getPricingTime();
+	for(unsigned int i=0; i < workerSolvers.size(); i++){
+		if(workerSolvers[i] != nullptr) pricingTime += workerSolvers[i]->getPricingTime();
+	}
+	cout << "Pricing time: " << pricingTime << "s";
+	if(parameters->useContractedNetwork()) cout << " (contracted network)";
+	cout << endl;
+	if(numWorkers > 1){
+		cout << "Stolen nodes: " << openNodes.getSteals() << " - Pool routes: " << columnPool->size() << endl;
+	}
+	if(nodeStore != nullptr){
+		cout << "Node store file: " << nodeStore->getFileSize() << " MB" << endl;
+	}
+	string levelNames[NUM_BRANCHING_LEVELS] = {"Machines", "Flow", "Time window", "Arc"};
+	for(int l=0; l < NUM_BRANCHING_LEVELS; l++){
+		cout << left << setw(12) << levelNames[l] << " branchings: " << setw(6) << branchingsPerLevel[l] << " closed nodes: " << closedPerLevel[l] << endl;
+	}
+	if(cutSeparator != nullptr){
+		cutPool->printStatistics(getIncumbent());
+	}
+	cout << sep << endl;
+
+	if(solutions.size() > 0){
+		cout << sep << endl;
+		cout << "BEST SOLUTION FOUND: " << endl;
+		cout << (*solutions.begin())->toString() << endl;
+		cout << sep << endl;
+	}else{
+		cout << "ATENTION: No solution found =( " << endl;
+		return GRB_INFEASIBLE;
+	}
+
+	//The search is complete, nothing to resume
+	if(parameters->getCheckpointFile() != ""){
+		remove(parameters->getCheckpointFile().c_str());
+	}
+
+	return GRB_OPTIMAL;
+}
+
+void Solver::searchTree(int worker, NodePool &openNodes)
+{
+	int owner;
+	Node *currentNode;
+	if(parameters->getTreeWorkers() > 1) initWorker(worker);
+	GRBEnv *workerEnv = (parameters->getTreeWorkers() > 1)? workerEnvs[worker] : env;
+	bool checkpointing = (parameters->getCheckpointFile() != "");
+	int idleWait = 1; //ms
+
+	//Until no node is open nor being evaluated by another worker
+	while(!openNodes.isFinished()){
+		//A checkpoint sees every node either open or in the snapshot of its worker
+		if(checkpointing) omp_set_lock(&checkpointLock);
+		currentNode = openNodes.pop(worker, owner);
+		if(currentNode != nullptr && checkpointing) nodeStore->snapshot(worker, currentNode);
+		if(checkpointing) omp_unset_lock(&checkpointLock);
+
+		//Idle: back off while the other workers give away nodes
+		if(currentNode == nullptr){
+			this_thread::sleep_for(chrono::milliseconds(idleWait));
+			idleWait = min(2 * idleWait, 64);
+			continue;
+		}
+		idleWait = 1;
+
+		//The incumbent may have improved since the node was created
+		if(currentNode->getParentZLP() >= getIncumbent() - parameters->getEpsilon()){
+			closeNode(currentNode);
+			delete currentNode;
+			openNodes.nodeDone(worker);
+			if(checkpointing) nodeStore->clearSnapshot(worker);
+			continue;
+		}
+
+		//Stored nodes are rebuilt and donated ones are read in the enviroment of this worker
+		if(currentNode->isStored()){
+			nodeStore->load(currentNode, workerEnv, worker);
+		}else if(currentNode->isDetached()){
+			currentNode->attach(workerEnv);
+		}
+
+		evaluateNode(currentNode, worker, openNodes);
+		openNodes.nodeDone(worker);
+
+		if(checkpointing){
+			omp_set_lock(&checkpointLock);
+			nodeStore->clearSnapshot(worker);
+			if(difftime(time(NULL), lastCheckpoint) >= parameters->getCheckpointInterval()){
+				writeCheckpoint(openNodes);
+				lastCheckpoint = time(NULL);
+			}
+			omp_unset_lock(&checkpointLock);
+		}
+	}
+}
+
+void Solver::writeCheckpoint(NodePool &openNodes)
+{
+	string fileName = parameters->getCheckpointFile();
+	string tempFile = fileName + ".tmp";
+	stringstream nodes, routes;
+
+	//Nodes first and routes and cuts after, so every column and cut of a node is in the file
+	int numNodes = openNodes.writeNodes(nodes) + nodeStore->writeSnapshots(nodes);
+	nodeStore->writeRoutes(routes);
+	cutPool->write(routes);
+
+	ofstream out(tempFile.c_str(), ios::out | ios::binary | ios::trunc);
+	int header[4] = {data->numJobs, data->horizonLength, routeCounter, exploredNodes};
+	out.write((char*)header, 4 * sizeof(int));
+	out.write((char*)&branchingsPerLevel[0], NUM_BRANCHING_LEVELS * sizeof(int));
+	out.write((char*)&closedPerLevel[0], NUM_BRANCHING_LEVELS * sizeof(int));
+
+	#pragma omp critical(incumbent)
+	{
+		int numSolutions = (solutions.size() > 0)? 1 : 0;
+		out.write((char*)&ZInc, sizeof(double));
+		out.write((char*)&numSolutions, sizeof(int));
+		if(numSolutions > 0) (*solutions.begin())->write(out);
+	}
+
+	string buffer = routes.str();
+	out.write(buffer.data(), buffer.size());
+	out.write((char*)&numNodes, sizeof(int));
+	buffer = nodes.str();
+	out.write(buffer.data(), buffer.size());
+	bool ok = out.good();
+	out.close();
+
+	//The previous checkpoint is only replaced by a complete one
+	if(ok){
+		remove(fileName.c_str());
+		rename(tempFile.c_str(), fileName.c_str());
+		cout << "Checkpoint written to " << fileName << ": " << numNodes << " open nodes, ZInc = " << getIncumbent() << endl;
+	}else{
+		cout << "Checkpoint could not be written to " << tempFile << endl;
+	}
+}
+
+bool Solver::readCheckpoint(vector<Node*> &openNodes)
+{
+	ifstream in(parameters->getCheckpointFile().c_str(), ios::in | ios::binary);
+	if(!in.is_open()) return false;
+
+	int header[4];
+	in.read((char*)header, 4 * sizeof(int));
+	if(header[0] != data->numJobs || header[1] != data->horizonLength){
+		cout << "Checkpoint belongs to another instance." << endl;
+		return false;
+	}
+	routeCounter = header[2];
+	exploredNodes = header[3];
+	in.read((char*)&branchingsPerLevel[0], NUM_BRANCHING_LEVELS * sizeof(int));
+	in.read((char*)&closedPerLevel[0], NUM_BRANCHING_LEVELS * sizeof(int));
+
+	int numSolutions;
+	in.read((char*)&ZInc, sizeof(double));
+	in.read((char*)&numSolutions, sizeof(int));
+	if(numSolutions > 0){
+		Solution *s = new Solution();
+		s->read(in);
+		solutions.insert(s);
+	}
+
+	vector<int> routeNumbers = nodeStore->readRoutes(in);
+	cutPool->read(in);
+
+	int numNodes;
+	in.read((char*)&numNodes, sizeof(int));
+	for(int i=0; i < numNodes; i++){
+		openNodes.push_back(nodeStore->readNode(in, cDualVars, eDualVars));
+	}
+	nodeStore->releaseRoutes(routeNumbers);
+
+	cout << "Resuming from " << parameters->getCheckpointFile() << ": " << numNodes << " open nodes, " 
+		<< exploredNodes << " explored nodes, ZInc = " << ZInc << endl;
+	return in.good();
+}
+
+void Solver::evaluateNode(Node *currentNode, int worker, NodePool &openNodes)
+{
+	int status;
+	int nodeId;
+	double eps = parameters->getEpsilon();
+	string sep = "-------------------------------------------------------------------";
+
+	//Serial search uses the main enviroment, tree workers their own ones
+	bool parallel = (parameters->getTreeWorkers() > 1);
+	SubproblemSolver *subproblem = parallel? workerSolvers[worker] : spSolver;
+
+	#pragma omp critical(nodeCounter)
+	nodeId = ++exploredNodes;
+
+	//Global lower bound: best bound among the open nodes and the ones being evaluated
+	double bound = openNodes.getBound();
+	double incumbent = getIncumbent();
+	stringstream output;
+	output << "Open nodes: " << openNodes.size() << " (" << openNodes.getMemoryUsage() << " MB)";
+	output << " - Bound: " << bound << " - Incumbent: " << incumbent;
+	if(incumbent < 1e13) output << " - Gap: " << 100.0 * (incumbent - bound) / max(incumbent, eps) << "%";
+	cout << output.str() << endl;
+
+	cout << sep << endl;
+	cout << "Starting column generation on node " << nodeId << endl;
+
+	currentNode->setNodeId(nodeId);
+	status = solveLPByColumnGeneration(currentNode, openNodes.size(), 0, subproblem);
+
+	cout << "Column generation on node " << nodeId << " completed." << endl;
+	cout << sep << endl;
+
+	//Learn pseudo costs from the bound change of the branch
+	if(status == GRB_OPTIMAL && currentNode->getBranchVariable().getType() != V_ERROR){
+		pseudoCosts.update(currentNode->getBranchVariable(), currentNode->getBranchRhs(), currentNode->getZLP() - currentNode->getParentZLP());
+	}
+
+	if(status != GRB_OPTIMAL){
+		cout << "Node " << nodeId << " INFEASIBLE. " << endl;
+		closeNode(currentNode);
+		delete currentNode;
+		return;
+	}else{
+		double Zlp = currentNode->getZLP();
+		if(currentNode->isIntegerSolution()){
+			updateIncumbent(currentNode, "");
+			closeNode(currentNode);
+			delete currentNode;
+			pruneOpenNodes(openNodes, worker);
+			return;
+		}
+
+		//Look for a better incumbent among the columns of the node
+		int freq = parameters->getRMPHeuristicFrequency();
+		if(freq > 0 && currentNode->getDepth() % freq == 0){
+			restrictedMasterHeuristic(currentNode);
+		}
+
+		//Dive from the root and periodically from open nodes
+		freq = parameters->getDivingFrequency();
+		if(freq > 0 && (nodeId == 1 || nodeId % freq == 0)){
+			priceAndDive(currentNode, subproblem);
+		}
+		pruneOpenNodes(openNodes, worker);
+
+		//Costs are not integer, so the bound can not be rounded up
+		incumbent = getIncumbent();
+		if(Zlp >= incumbent - eps){
+			cout << "Node " << nodeId << " PRUNED BY BOUND. " << Zlp << " >= " << incumbent << endl;
+			closeNode(currentNode);
+			delete currentNode;
+			return;
+		}
+
+		//A small root gap leaves few candidate routes: enumerate them instead of branching.
+		//The reduced costs must come from exact duals, as for reduced cost fixing
+		if(currentNode->getDepth() == 0 && !parameters->useDualStabilization() && solveByEnumeration(currentNode, subproblem)){
+			closeNode(currentNode);
+			delete currentNode;
+			pruneOpenNodes(openNodes, worker);
+			return;
+		}
+	}
+	
+	//Node cleaning
+	cout << sep << endl;
+	cout << "Cleaning node. " << endl;
+	int cleaned = currentNode->cleanNode(500);
+	cout << cleaned << " routes eliminated." << endl;
+	cout << sep << endl;
+
+	//Fix by reduced costs.
+	cout << sep << endl;
+	cout << "Fixating variables by reduced cost before branching. " << endl;
+	int fix = currentNode->fixVarsByReducedCost(getIncumbent() - currentNode->getZLP());
+	cout << fix << " variables fixed to 0 and removed from the pricing network." << endl;
+	cout << sep << endl;
+
+	//Get branching candidate
+	Variable branchV = getBranchingVariable(currentNode, parallel? worker : -1);
+	if(branchV.getType() == V_ERROR){
+		cout << "Node " << nodeId << " has no branching candidate. " << endl;
+		closeNode(currentNode);
+		delete currentNode;
+		return;
+	}
+	cout << sep << endl;
+	cout << "Branching on variable: " << branchV.toString() << endl;
+	cout << sep << endl;
+	#pragma omp atomic
+	branchingsPerLevel[Node::getBranchingLevel(branchV)]++;
+
+	//Children start from the basis of the parent
+	currentNode->saveBasis();
+
+	//Add two nodes to the queue of this worker
+	Node *nodeIzq = new Node(*currentNode);
+	Node *nodeDer = new Node(*currentNode);
+
+	nodeIzq->addBranchConstraint(branchV, 0.0);
+	nodeDer->addBranchConstraint(branchV, 1.0);
+	nodeIzq->setBranch(branchV, 0.0, currentNode->getZLP());
+	nodeDer->setBranch(branchV, 1.0, currentNode->getZLP());
+
+	//Estimate of the best integer solution below each child, from the gain of its own branch direction
+	double downGain, upGain;
+	pseudoCosts.getGains(branchV, downGain, upGain);
+	nodeIzq->setEstimate(currentNode->getZLP() + downGain);
+	nodeDer->setEstimate(currentNode->getZLP() + upGain);
+
+	openNodes.push(worker, nodeIzq);
+	openNodes.push(worker, nodeDer);
+	
+	//parent node not needed anymore
+	delete currentNode;
+}
+
+void Solver::buildProblemNetwork()
+{
+	cout << "Creating problem network." << endl;
+	clock_t buildStart = clock();
+	int numJobs = data->numJobs;
+	int horizon = data->horizonLength;
+
+	//Vertices reached from the depot at 0 that can still reach the depot at the horizon, for each equipment type.
+	//Types do not share anything, so they are computed in parallel.
+	vector<vector<pair<int,int>>> live = vector<vector<pair<int,int>>>(data->numEquipments);
+	if(data->timePoints.size() > 0){
+		//Partial discretization: the passes may add time points, so they run sequentially until none is added
+		int numPoints = -1;
+		while(numPoints != data->getNumTimePoints()){
+			numPoints = data->getNumTimePoints();
+			for(int eqType=0; eqType < data->numEquipments; eqType++){
+				live[eqType] = getLiveVertices(eqType);
+			}
+		}
+	}else{
+		#pragma omp parallel for num_threads(parameters->getNumThreads()) schedule(dynamic)
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			live[eqType] = getLiveVertices(eqType);
+		}
+	}
+
+	//Vertices live for some type, taken from one block in topological order (so the set is filled at its end)
+	vector<pair<int,int>> vertices;
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		vertices.insert(vertices.end(), live[eqType].begin(), live[eqType].end());
+	}
+	sort(vertices.begin(), vertices.end());
+	vertices.erase(unique(vertices.begin(), vertices.end()), vertices.end());
+	int numVertices = vertices.size();
+
+	data->vertexPool = vector<Vertex>(numVertices, Vertex(data->numEquipments));
+	for(int v=0; v < numVertices; v++){
+		Vertex *o = &data->vertexPool[v];
+		o->setJob(vertices[v].second);
+		o->setTime(vertices[v].first);
+		o->setId(v);
+		data->vertexSet.insert(data->vertexSet.end(), o);
+	}
+
+	//Time range of the vertices of each job in the (job,time) index
+	vector<int> firstTime = vector<int>(numJobs, horizon + 1);
+	vector<int> lastTime = vector<int>(numJobs, -1);
+	for(int v=0; v < numVertices; v++){
+		Vertex *o = &data->vertexPool[v];
+		firstTime[o->getJob()] = min(firstTime[o->getJob()], o->getTime());
+		lastTime[o->getJob()] = max(lastTime[o->getJob()], o->getTime());
+	}
+	for(int j=0; j < numJobs; j++){
+		data->problemNetwork.reserve(j, firstTime[j], lastTime[j]);
+	}
+	for(int v=0; v < numVertices; v++){
+		data->problemNetwork.add(&data->vertexPool[v]);
+	}
+
+	//Live vertices of each type by vertex id
+	vector<vector<char>> alive = vector<vector<char>>(data->numEquipments, vector<char>(numVertices, 0));
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		for(unsigned int k=0; k < live[eqType].size(); k++){
+			alive[eqType][data->problemNetwork.get(live[eqType][k].second, live[eqType][k].first)->getId()] = 1;
+		}
+	}
+
+	//Arcs between live vertices, each type only writes its own adjacence and incidence lists
+	#pragma omp parallel for num_threads(parameters->getNumThreads()) schedule(dynamic)
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		vector<pair<int,int>> successors;
+		for(int v=0; v < numVertices; v++){
+			Vertex *o = &data->vertexPool[v];
+			if(!alive[eqType][v]) continue;
+
+			getNetworkSuccessors(eqType, o->getJob(), o->getTime(), successors);
+			for(unsigned int s=0; s < successors.size(); s++){
+				Vertex *d = data->problemNetwork.get(successors[s].first, successors[s].second);
+				if(d == nullptr || !alive[eqType][d->getId()]) continue;
+
+				o->addAdjacentVertex(eqType,d);
+				d->addInicidentVertex(eqType,o);
+			}
+		}
+	}
+
+	//Number the arcs (adjacence lists in topological order) for the pricing masks of the nodes
+	data->numArcs = 0;
+	set<Vertex*,VertexComparator>::iterator vit = data->vertexSet.begin();
+	for(; vit != data->vertexSet.end(); vit++){
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			(*vit)->setFirstArc(eqType, data->numArcs);
+			data->numArcs += (*vit)->getAdjacenceList(eqType).size();
+		}
+	}
+	cout << "Total vertices in problem network: " << data->vertexSet.size() << endl;
+	cout << "Total arcs in problem network: " << data->numArcs << endl;
+	cout << "Problem network built in " << (double)(clock() - buildStart)/CLOCKS_PER_SEC << "s" << endl;
+}
+
+void Solver::getNetworkSuccessors(int eqType, int job, int time, vector<pair<int,int>> &successors)
+{
+	//(job,time) heads of the arcs leaving vertex (job,time) for eqType: service arcs to the other jobs,
+	//return to the depot and waiting until the next start time period of the same job.
+	//With the work shift decomposition every arc stays in the shift of time and the depot is reached at its end
+	successors.clear();
+	Job *sJob = data->jobs[job];
+	Equipment *e = data->equipments[eqType];
+	int shiftEnd = data->getShiftEnd(time);
+
+	//Verify equipment requirement of job s (the depot only leaves at the start of a shift)
+	if(job != 0 && !sJob->getEquipmentTypeRequired(eqType)) return;
+	if(job == 0 && (time >= data->horizonLength || data->getShiftStart(time) != time)) return;
+
+	//Verify that vertex s belongs to the time window of sJob (sJob can be attended at this time)
+	if(job == 0 || sJob->isStartTimeFeasible(time)){
+		for(int j=1; j < data->numJobs; j++){
+			Job *jJob = data->jobs[j];
+			if(job == j || !jJob->getEquipmentTypeRequired(eqType)) continue;
+
+			//Verify time window compatibility (arriving between work shifts is waiting for the next one).
+			//A successor of job by precedence can not start before the lag is over, and a job that job has
+			//to follow can not be served after it
+			int delta;
+			int earliest = time + sJob->getServiceTime() + (int)e->getTransitionTime(job,j);
+			if(data->getPrecedenceLag(job, j, delta)) earliest = max(earliest, time + delta);
+			int arriveTime = jJob->getNextStartTime(earliest);
+			if(arriveTime < 0 || (shiftEnd < data->horizonLength && arriveTime >= shiftEnd)) continue;
+			if(data->getPrecedenceLag(j, job, delta) && arriveTime > time - delta) continue;
+
+			//With a partial discretization the arc ends at the last time point not after the arrival (too short arc),
+			//unless that point is not later than time: the network must stay acyclic, so the arrival becomes a point
+			int point = data->getTimePoint(j, arriveTime);
+			if(point >= 0 && point <= time && data->addTimePoint(j, arriveTime)) point = arriveTime;
+			arriveTime = point;
+
+			successors.push_back(make_pair(j, arriveTime));
+		}
+
+		if(job != 0) successors.push_back(make_pair(0, shiftEnd));
+	}
+
+	//Waiting within the shift (a machine may also stay at the depot for a whole shift)
+	int waitTime = -1;
+	if(job != 0){
+		waitTime = data->getNextTimePoint(job, time+1);
+		if(shiftEnd < data->horizonLength && waitTime >= shiftEnd) waitTime = -1;
+	}else if(data->getNumNetworkShifts() > 1){
+		waitTime = shiftEnd;
+	}
+	if(waitTime > 0) successors.push_back(make_pair(job, waitTime));
+}
+
+vector<pair<int,int>> Solver::getLiveVertices(int eqType)
+{
+	//Forward pass from the depot at 0 over the reached (time, job) vertices in topological order.
+	//Successors are later than their vertex, so they are inserted ahead of the one visited
+	set<pair<int,int>> reachedSet;
+	vector<pair<int,int>> successors;
+	reachedSet.insert(make_pair(0, 0));
+	for(set<pair<int,int>>::iterator it = reachedSet.begin(); it != reachedSet.end(); it++){
+		getNetworkSuccessors(eqType, it->second, it->first, successors);
+		for(unsigned int s=0; s < successors.size(); s++){
+			reachedSet.insert(make_pair(successors[s].second, successors[s].first));
+		}
+	}
+	vector<pair<int,int>> reached = vector<pair<int,int>>(reachedSet.begin(), reachedSet.end());
+
+	//Backward pass: a reached vertex is live if it is the end depot or has a live successor
+	vector<char> alive = vector<char>(reached.size(), 0);
+	pair<int,int> endDepot = make_pair(data->horizonLength, 0);
+	for(int r=(int)reached.size()-1; r >= 0; r--){
+		if(reached[r] == endDepot){
+			alive[r] = 1;
+			continue;
+		}
+
+		getNetworkSuccessors(eqType, reached[r].second, reached[r].first, successors);
+		for(unsigned int s=0; s < successors.size(); s++){
+			pair<int,int> d = make_pair(successors[s].second, successors[s].first);
+			vector<pair<int,int>>::iterator it = lower_bound(reached.begin(), reached.end(), d);
+			if(it != reached.end() && *it == d && alive[it - reached.begin()]){
+				alive[r] = 1;
+				break;
+			}
+		}
+	}
+
+	//The start depot (the first reached vertex) is always kept
+	alive[0] = 1;
+	vector<pair<int,int>> liveVertices;
+	for(unsigned int r=0; r < reached.size(); r++){
+		if(alive[r]) liveVertices.push_back(reached[r]);
+	}
+	return liveVertices;
 }
\ No newline at end of file
@@ -1,72 +1,114 @@
-#pragma once
-
-#include "gurobi_c++.h"
-#include "Data.h"
-#include "Variable.h"
-#include "Constraint.h"
-#include "Solution.h"
-#include "GlobalParameters.h"
-
-#include <time.h>
-#include <set>
-
-#ifdef DEBUG
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
-#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
-#define new DEBUG_NEW
-#endif
-
-using namespace std;
-
-class SubproblemSolver;
-class Node;
-class Route;
-
-class Solver
-{
-public:
-	Solver(ProblemData *d);
-	~Solver();
-
-	//Model object and enviroment
-	GRBEnv *env;
-	GRBModel *model;
-
-	//Variables
-	VariableHash vHash;
-
-	//Constraints
-	ConstraintHash cHash;
-	
-	int solve();
-private:
-	ProblemData *data;	
-	GlobalParameters *parameters;
-	SubproblemSolver *spSolver;
-	set<Solution*> solutions;
-
-	double bigM;
-
-	//Global 
-	double ZInc;
-	int eDualVars;
-	int cDualVars;
-
-	//Statistics
-	int routeCounter;
-	int totalNodes;
-	int exploredNodes;
-	clock_t tStart;
-
-	//Methods
-	void buildProblemNetwork();
-	void buildInitialModel();
-	void buildDWM();
-	void collapseSubproblemVertices();
-	
-	int BaP(Node *node);
-	int getFeasibleSolution();
-	int solveLPByColumnGeneration(Node *node, int treeSize);
-};
+#pragma once
+
+#include "gurobi_c++.h"
+#include "Data.h"
+#include "Variable.h"
+#include "Constraint.h"
+#include "Solution.h"
+#include "GlobalParameters.h"
+#include "PseudoCost.h"
+#include "NodePool.h"
+#include "ColumnPool.h"
+#include "CutPool.h"
+#include "CutSeparator.h"
+#include "NodeStore.h"
+
+#include <time.h>
+#include <set>
+#include <vector>
+#include <omp.h>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+class SubproblemSolver;
+class Node;
+class Route;
+
+class Solver
+{
+public:
+	Solver(ProblemData *d);
+	~Solver();
+
+	//Model object and enviroment
+	GRBEnv *env;
+	GRBModel *model;
+
+	//Variables
+	VariableHash vHash;
+
+	//Constraints
+	ConstraintHash cHash;
+	
+	int solve();
+	Solution *getBestSolution(){ return (solutions.size() > 0)? *solutions.begin() : nullptr; }
+private:
+	ProblemData *data;	
+	GlobalParameters *parameters;
+	SubproblemSolver *spSolver;
+
+	//Parallel workers (one Gurobi enviroment and subproblem solver each)
+	vector<GRBEnv*> workerEnvs;
+	vector<SubproblemSolver*> workerSolvers;
+	ColumnPool *columnPool;
+	CutPool *cutPool;
+	CutSeparator *cutSeparator;
+	NodeStore *nodeStore;
+	set<Solution*,SolutionComparator> solutions;
+	vector<Route*> initialRoutes;
+	PseudoCostStore pseudoCosts;
+
+	double bigM;
+
+	//Global (shared by the tree workers, see getIncumbent and updateIncumbent)
+	double ZInc;
+	int eDualVars;
+	int cDualVars;
+
+	//Statistics
+	int routeCounter;
+	int totalNodes;
+	int exploredNodes;
+	clock_t tStart;
+	double strongBranchingTime;
+	vector<int> branchingsPerLevel;
+	vector<int> closedPerLevel;
+
+	//Checkpoints: last one written and lock taken by the workers while a node changes hands
+	time_t lastCheckpoint;
+	omp_lock_t checkpointLock;
+
+	//Methods
+	void buildProblemNetwork();
+	void getNetworkSuccessors(int eqType, int job, int time, vector<pair<int,int>> &successors);
+	vector<pair<int,int>> getLiveVertices(int eqType);
+	void buildInitialModel(bool ovf);
+	void buildDWM();
+	
+	int BaP(const vector<Node*> &nodes);
+	void searchTree(int worker, NodePool &openNodes);
+	void initWorker(int w);
+	void evaluateNode(Node *currentNode, int worker, NodePool &openNodes);
+	int getFeasibleSolution();
+	int restrictedMasterHeuristic(Node *node);
+	int priceAndDive(Node *node, SubproblemSolver *subproblem = nullptr);
+	bool solveByEnumeration(Node *node, SubproblemSolver *subproblem);
+	int separateCuts(Node *node, CutFamily &family);
+	const Variable getBranchingVariable(Node *node, int worker = -1);
+	void closeNode(Node *node);
+	int pruneOpenNodes(NodePool &openNodes, int worker);
+	double getIncumbent();
+	bool updateIncumbent(Node *node, const string &origin);
+	void writeCheckpoint(NodePool &openNodes);
+	bool readCheckpoint(vector<Node*> &openNodes);
+	vector<double> strongBranching(Node *node, const vector<Variable> &candidates, int worker = -1);
+	int solveLPByColumnGeneration(Node *node, int treeSize, int maxIterations = 0, SubproblemSolver *subproblem = nullptr);
+};
@@ -1,231 +1,883 @@
-#include "gurobi_c++.h"
-#include "SubproblemSolver.h"
-#include "Solver.h"
-#include "Node.h"
-#include "Variable.h"
-#include "Constraint.h"
-
-#include <iostream>
-#include <iomanip>
-#include <queue>
-
-SubproblemSolver::SubproblemSolver(ProblemData *d, SubproblemType m) : data(d), method(m)
-{
-	infinityValue = 1e13;
-
-	//Initialize fixatedVars vector
-	fixatedVars = vector<int>(data->numJobs,0);	
-
-	//Visited vertex vector
-	vector<vector<bool>> visited = vector<vector<bool>>(data->numJobs, vector<bool>(data->horizonLength+1,false));
-
-	//Initialize reduced costs matrix
-	reducedCosts = vector<vector<vector<double> > >(data->numJobs, 
-		vector<vector<double> >(data->numJobs, vector<double>(data->horizonLength + 1)));
-
-	//Initialize FMatrix
-	fMatrix = vector<vector<Bucket*> >(data->numJobs, vector<Bucket*>(data->horizonLength + 1));
-	for(int j=0; j < data->numJobs; j++){
-		for(int t=0; t <= data->horizonLength; t++){
-			switch(method){
-				case QROUTE:
-					fMatrix[j][t] = new QRouteBucket();
-					break;
-				case QROUTE_NOLOOP:
-					fMatrix[j][t] = new QRouteNoLoopBucket();
-					break;
-			}
-
-			fMatrix[j][t]->setJob(j);
-			fMatrix[j][t]->setTime(t);
-		}
-	}
-
-	//Initialize routes vector
-	routes = vector<Route*>();
-
-	//Global parameters
-	parameters = GlobalParameters::getInstance();
-
-}
-
-SubproblemSolver::~SubproblemSolver()
-{
-	//fixatedVars
-	fixatedVars.clear();
-
-	//Reduced Costs Matrix
-	reducedCosts.clear();
-
-	//FMatrix
-	fMatrix.clear();
-
-	//Routes
-	routes.clear();
-}
-
-void SubproblemSolver::reset()
-{
-	infeasible = false;
-
-	//reset reduced costs matrix and fMatrix
-	for(int j=0; j < data->numJobs; j++){
-		for(int t=0; t <= data->horizonLength; t++){
-			fMatrix[j][t]->reset();
-			for(int i=0; i < data->numJobs; i++){
-				reducedCosts[j][i][t] = 0;
-			}
-		}
-	}
-
-	//erase all previously generated routes
-	routes.clear();
-}
-
-void SubproblemSolver::collapseVertices(Node *node, int eqType)
-{
-	Variable v;
-
-	infeasible = false;
-	fixatedVars.clear();
-
-	queue<Vertex*> myQueue;	
-	for(int eqType=0; eqType < data->numEquipments; eqType++){
-		Equipment *e = data->equipments[eqType];
-
-		//Make a BFS over the problem network
-		Vertex *o, *d;
-		o = data->problemNetwork[0][0]; //depot
-
-		myQueue.push(o);
-		visited = vector<vector<bool>>(data->numJobs, vector<bool>(data->horizonLength+1,false));
-
-		while(myQueue.size() > 0){
-			o = myQueue.front();			
-			myQueue.pop();
-			int oJob = o->getJob();
-			int oTime = o->getTime();
-
-			if(!visited[oJob][oTime]){
-				visited[oJob][oTime] = true;
-
-				//Iterate through adjacence list for job o and eqType
-				vector<Vertex*>::iterator it = o->getAdjacenceList(eqType).begin();
-				vector<Vertex*>::iterator eit = o->getAdjacenceList(eqType).end();
-				for(; it != eit; it++){
-					d = (*it);
-					int dJob = d->getJob();
-					int dTime = d->getTime();
-
-					if(oJob != dJob){ //not waiting
-						//Verify associated variable bound
-						v.reset();
-						v.setType(V_X);
-						v.setStartJob(oJob);
-						v.setEndJob(dJob);
-						v.setTime(oTime);
-						v.setEquipmentTipe(eqType);
-
-						double lb = node->getVarLB(v);
-						//If variable is fixated to 1, then collapse associated vertices (buckets)
-						if(lb == 1){
-							//"Colapse" associated vertices 
-							fMatrix[oJob][oTime]->setSuccessor(fMatrix[dJob][dTime]);
-
-							//Verify Conflicts (for the same job)
-							fixatedVars[oJob] ++;
-							if(fixatedVars[oJob] > 1){
-								infeasible = true;
-								return; //current master node is infeasible
-							}
-						}
-					}
-					myQueue.push(d);
-				}
-			}
-		}
-	}
-}
-
-void SubproblemSolver::solve(Node *node, int eqType, int maxRoutes)
-{
-	//Reset buckets and reduced costs matrix
-	reset();
-
-	//If there are conflicts there is no solution.
- 	if(infeasible)
-		return;
-
-	//Update reduced costs matrix
-	double routeUseCost = node->getRouteUseReducedCost(eqType);
-	
-	//Dynamic Programming
-	Vertex *p, *next;
-	int pJob, pTime;
-	int cJob, cTime, nJob, nTime;
-	double rc;
-
-	vector<Vertex*> incidenceList, adjacenceList;	
-	vector<Vertex*>::iterator itVertex, eitVertex;
-
-	fMatrix[0][0]->addLabel(new Label(0,0,0));
-
-	//Reaching algorithm
-	Vertex *currentVertex, *nextVertex;
-	set<Vertex*,VertexComparator>::iterator vit = data->vertexSet.begin();
-	set<Vertex*,VertexComparator>::iterator veit = data->vertexSet.end();
-
-	while(vit != veit){
-		currentVertex = (*vit);
-		cJob = currentVertex->getJob();
-		cTime = currentVertex->getTime();
-
-		adjacenceList = currentVertex->getAdjacenceList(eqType);
-		itVertex = adjacenceList.begin();
-		eitVertex = adjacenceList.end();
-		for(; itVertex != eitVertex; itVertex++){
-			nextVertex = (*itVertex);
-			nJob = nextVertex->getJob();
-			nTime = nextVertex->getTime();
-
-			rc = (cJob == nJob)? 0 : node->getArcReducedCost(cJob,nJob,cTime,eqType);
-
-			fMatrix[nJob][nTime]->evaluate(fMatrix[cJob][cTime]->getLabels(), rc, false);
-		}
-		vit++;
-	}
-
-	//BUILD ROUTES
-	Route *myRoute;
-	int contRoutes = 0;
-	set<Label*,LabelComparator>::iterator it = fMatrix[0][data->horizonLength]->getLabels().begin();
-	set<Label*,LabelComparator>::iterator eit = fMatrix[0][data->horizonLength]->getLabels().end();
-	while(it != eit){
-		Label *currentLabel = (*it);
-		if(currentLabel == nullptr){
-			return;
-		}
-
-		myRoute = new Route(eqType);
-		myRoute->setCost(currentLabel->getCost() - routeUseCost);
-
-		if(myRoute->getCost() >= -parameters->getEpsilon()) break; //labels are ordered by reduced cost.
-
-		Label *previousLabel = currentLabel->getPredecessor();
-		while(previousLabel != nullptr){
-			if(currentLabel->getJob() != previousLabel->getJob()){ //not waiting
-				myRoute->edges.push_back(new Edge(previousLabel->getJob(),currentLabel->getJob(), previousLabel->getTime()));
-			}
-			currentLabel = previousLabel;
-			previousLabel = currentLabel->getPredecessor();		
-		}
-
-		routes.push_back(myRoute);
-		contRoutes++;
-		if(contRoutes >= parameters->getMaxRoutes())
-			break;
-
-		it++;
-	}
-
-}
+#include "gurobi_c++.h"
+#include "SubproblemSolver.h"
+#include "Solver.h"
+#include "Node.h"
+#include "Variable.h"
+#include "Constraint.h"
+#include "CutPool.h"
+
+#include <iostream>
+#include <iomanip>
+#include <queue>
+#include <algorithm>
+#include <ctime>
+
+SubproblemSolver::SubproblemSolver(ProblemData *d, SubproblemType m) : data(d), method(m), loadCapacity(0), loadResource(false)
+{
+	infinityValue = 1e13;
+
+	//Load capacities that can bind, per equipment type
+	loadCapacities = vector<int>(data->numEquipments, 0);
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		loadCapacities[eqType] = data->getLoadCapacity(eqType);
+		if(loadCapacities[eqType] > 0) loadResource = true;
+	}
+
+	//Initialize buckets (one per vertex of the problem network, which must be built already)
+	buckets = vector<Bucket*>(data->vertexPool.size(), nullptr);
+	for(unsigned int v=0; v < data->vertexPool.size(); v++){
+		buckets[v] = createBucket(data->vertexPool[v].getJob(), data->vertexPool[v].getTime());
+	}
+
+	//Shifts of the network (one without the work shift decomposition)
+	int numShifts = data->getNumNetworkShifts();
+	Vertex shiftStart(data->numEquipments);
+	shiftStart.setJob(-1);
+	for(int s=0; s < numShifts; s++){
+		shiftStart.setTime(s * data->workShiftLength);
+		shiftFirstVertex.push_back(data->vertexSet.lower_bound(&shiftStart));
+		shiftEndBuckets.push_back(createBucket(0, data->getShiftEnd(s * data->workShiftLength)));
+	}
+	shiftFirstVertex.push_back(data->vertexSet.end());
+
+	//Initialize routes vector
+	routes = vector<Route*>();
+
+	//Global parameters
+	parameters = GlobalParameters::getInstance();
+
+	pricingTime = 0.0;
+	if(parameters->useContractedNetwork()) buildContractedNetwork();
+}
+
+SubproblemSolver::~SubproblemSolver()
+{
+	//Buckets
+	for(unsigned int v=0; v < buckets.size(); v++){
+		delete buckets[v];
+	}
+	buckets.clear();
+
+	//Routes
+	routes.clear();
+	chains.clear();
+
+	for(unsigned int s=0; s < shiftEndBuckets.size(); s++){
+		delete shiftEndBuckets[s];
+	}
+	shiftEndBuckets.clear();
+}
+
+Bucket *SubproblemSolver::createBucket(int job, int time)
+{
+	Bucket *bucket = nullptr;
+	switch(method){
+		case QROUTE:
+			bucket = new QRouteBucket();
+			break;
+		case QROUTE_NOLOOP:
+			//The depot unloads, so its labels all have load 0 and are kept by cost
+			if(loadResource && job != 0)
+				bucket = new ParetoBucket();
+			else
+				bucket = new QRouteNoLoopBucket();
+			break;
+	}
+
+	bucket->setJob(job);
+	bucket->setTime(time);
+	return bucket;
+}
+
+Bucket *SubproblemSolver::getBucket(int job, int time)
+{
+	Vertex *v = data->problemNetwork.get(job, time);
+	return (v != nullptr)? buckets[v->getId()] : nullptr;
+}
+
+void SubproblemSolver::reset()
+{
+	infeasible = false;
+
+	//reset the buckets labeled by the last solve
+	for(unsigned int v=0; v < buckets.size(); v++){
+		if(!buckets[v]->isEmpty()) buckets[v]->reset();
+	}
+
+	//erase all previously generated routes
+	routes.clear();
+}
+
+bool SubproblemSolver::propagateBranching(Node *node)
+{
+	vector<bool> &arcMask = node->getArcMask();
+	vector<pair<Variable,double>> &decisions = node->getPendingDecisions();
+
+	infeasible = false;
+
+	//Root node: nothing removed yet
+	if(arcMask.size() == 0){
+		arcMask = vector<bool>(data->numArcs, false);
+	}
+	vector<Variable> &removals = node->getPendingRemovals();
+	if(decisions.size() == 0 && removals.size() == 0) return true;
+
+	vector<pair<Variable,double>>::iterator it = decisions.begin();
+	for(; it != decisions.end(); it++){
+		Variable v = it->first;
+		bool one = (it->second > 0.5);
+
+		switch(Node::getBranchingLevel(v)){
+			case BRANCH_ARC:
+				if(one){
+					fixArc(node, v.getStartJob(), v.getEndJob(), v.getTime(), v.getEquipmentType());
+				}else{
+					int id = getArcId(v.getStartJob(), v.getEndJob(), v.getTime(), v.getEquipmentType());
+					if(id >= 0) removeArc(node, id);
+				}
+				break;
+			case BRANCH_FLOW:
+				applyFlowBranch(node, v.getStartJob(), v.getEndJob(), v.getEquipmentType(), one);
+				break;
+			case BRANCH_TIME_WINDOW:
+				applyTimeWindow(node, v.getStartJob());
+				break;
+			default: //machines and dive fixings of lambda do not change the network
+				break;
+		}
+	}
+	decisions.clear();
+
+	//Reduced cost fixings: arcs and start times that can not be part of an improving solution
+	vector<Variable>::iterator rit = removals.begin();
+	for(; rit != removals.end(); rit++){
+		if(rit->getType() == V_X){
+			int id = getArcId(rit->getStartJob(), rit->getEndJob(), rit->getTime(), rit->getEquipmentType());
+			if(id >= 0) removeArc(node, id);
+		}else if(rit->getType() == V_Y && data->problemNetwork.get(rit->getStartJob(), rit->getTime()) != nullptr){
+			for(int eqType=0; eqType < data->numEquipments; eqType++){
+				removeServiceArcs(node, data->problemNetwork.get(rit->getStartJob(), rit->getTime()), eqType, -1);
+			}
+		}
+	}
+	removals.clear();
+
+	//Arcs fixed to 1 must survive the propagation of the other decisions
+	vector<int>::iterator fit = node->getFixedArcs().begin();
+	for(; fit != node->getFixedArcs().end(); fit++){
+		if(arcMask[*fit]){
+			infeasible = true;
+			return false;
+		}
+	}
+
+	infeasible = !isNetworkFeasible(node);
+	return !infeasible;
+}
+
+bool SubproblemSolver::isRouteAllowed(Node *node, Route *route)
+{
+	//Waiting arcs are only removed after a time window, so checking the service arcs is enough
+	vector<bool> &arcMask = node->getArcMask();
+	vector<Edge*>::iterator eit = route->edges.begin();
+	for(; eit != route->edges.end(); eit++){
+		int id = getArcId((*eit)->getStartJob(), (*eit)->getEndJob(), (*eit)->getTime(), route->getEquipmentType());
+		if(id < 0 || arcMask[id]) return false;
+	}
+
+	return true;
+}
+
+int SubproblemSolver::getArcId(int sJob, int dJob, int time, int eqType)
+{
+	Vertex *v = data->problemNetwork.get(sJob, time);
+	if(v == nullptr) return -1;
+
+	vector<Vertex*> &adjacenceList = v->getAdjacenceList(eqType);
+	for(unsigned int k=0; k < adjacenceList.size(); k++){
+		if(adjacenceList[k]->getJob() == dJob)
+			return v->getArcId(eqType, k);
+	}
+
+	return -1;
+}
+
+void SubproblemSolver::removeServiceArcs(Node *node, Vertex *v, int eqType, int keepJob)
+{
+	//Remove arcs leaving v towards other jobs (waiting arcs and arcs to keepJob are kept)
+	vector<Vertex*> &adjacenceList = v->getAdjacenceList(eqType);
+	for(unsigned int k=0; k < adjacenceList.size(); k++){
+		int dJob = adjacenceList[k]->getJob();
+		if(dJob != v->getJob() && dJob != keepJob)
+			removeArc(node, v->getArcId(eqType, k));
+	}
+}
+
+void SubproblemSolver::removeIncomingArcs(Node *node, int job, int eqType, int keepJob)
+{
+	//Remove arcs entering any time copy of job from jobs other than keepJob
+	for(int t=data->problemNetwork.getFirstTime(job); t <= data->problemNetwork.getLastTime(job); t++){
+		Vertex *d = data->problemNetwork.get(job, t);
+		if(d == nullptr) continue;
+
+		vector<Vertex*> &incidenceList = d->getIncidenceList(eqType);
+		for(unsigned int i=0; i < incidenceList.size(); i++){
+			Vertex *o = incidenceList[i];
+			if(o->getJob() == job || o->getJob() == keepJob) continue;
+
+			vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				if(adjacenceList[k] == d) removeArc(node, o->getArcId(eqType, k));
+			}
+		}
+	}
+}
+
+void SubproblemSolver::fixArc(Node *node, int sJob, int dJob, int time, int eqType)
+{
+	int id = getArcId(sJob, dJob, time, eqType);
+	if(id < 0){
+		infeasible = true;
+		return;
+	}
+	node->getFixedArcs().push_back(id);
+
+	if(sJob != 0){
+		//sJob starts at time on every machine (synchronization)
+		for(int eq=0; eq < data->numEquipments; eq++){
+			if(!data->jobs[sJob]->getEquipmentTypeRequired(eq)) continue;
+			for(int t=data->problemNetwork.getFirstTime(sJob); t <= data->problemNetwork.getLastTime(sJob); t++){
+				Vertex *v = data->problemNetwork.get(sJob, t);
+				if(v == nullptr || t == time) continue;
+				removeServiceArcs(node, v, eq, -1);
+			}
+		}
+
+		//and goes to dJob next on this equipment type
+		removeServiceArcs(node, data->problemNetwork.get(sJob, time), eqType, dJob);
+	}
+
+	//dJob comes right after sJob on this equipment type
+	if(dJob != 0){
+		removeIncomingArcs(node, dJob, eqType, sJob);
+	}
+}
+
+void SubproblemSolver::applyFlowBranch(Node *node, int sJob, int dJob, int eqType, bool used)
+{
+	for(int t=data->problemNetwork.getFirstTime(sJob); t <= data->problemNetwork.getLastTime(sJob); t++){
+		Vertex *v = data->problemNetwork.get(sJob, t);
+		if(v == nullptr) continue;
+
+		if(used){
+			//No other arc leaves sJob on this equipment type
+			removeServiceArcs(node, v, eqType, dJob);
+		}else{
+			//No arc from sJob to dJob in any time copy
+			vector<Vertex*> &adjacenceList = v->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				if(adjacenceList[k]->getJob() == dJob)
+					removeArc(node, v->getArcId(eqType, k));
+			}
+		}
+	}
+
+	//No other arc enters dJob on this equipment type
+	if(used){
+		removeIncomingArcs(node, dJob, eqType, sJob);
+	}
+}
+
+void SubproblemSolver::applyTimeWindow(Node *node, int job)
+{
+	for(int t=data->problemNetwork.getFirstTime(job); t <= data->problemNetwork.getLastTime(job); t++){
+		Vertex *v = data->problemNetwork.get(job, t);
+		if(v == nullptr) continue;
+
+		for(int eqType=0; eqType < data->numEquipments; eqType++){
+			if(t > node->getStartTimeUB(job)){
+				//After the window the vertex is removed
+				vector<Vertex*> &adjacenceList = v->getAdjacenceList(eqType);
+				for(unsigned int k=0; k < adjacenceList.size(); k++){
+					removeArc(node, v->getArcId(eqType, k));
+				}
+			}else if(t < node->getStartTimeLB(job)){
+				//Before the window the vertex is only kept to wait for the window to open
+				removeServiceArcs(node, v, eqType, -1);
+			}
+		}
+	}
+}
+
+bool SubproblemSolver::isNetworkFeasible(Node *node)
+{
+	vector<bool> &arcMask = node->getArcMask();
+	set<Vertex*,VertexComparator>::iterator vit;
+	set<Vertex*,VertexComparator>::reverse_iterator rvit;
+
+	Vertex *start = data->problemNetwork.get(0, 0);
+	Vertex *end = data->problemNetwork.get(0, data->horizonLength);
+
+	//Vertices reachable from the depot and vertices that can reach the end depot (by vertex id)
+	vector<bool> reached, canReturn;
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		reached.assign(data->vertexPool.size(), false);
+		canReturn.assign(data->vertexPool.size(), false);
+		reached[start->getId()] = true;
+		if(end != nullptr) canReturn[end->getId()] = true;
+
+		for(vit = data->vertexSet.begin(); vit != data->vertexSet.end(); vit++){
+			Vertex *o = (*vit);
+			if(!reached[o->getId()]) continue;
+
+			vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				if(!arcMask[o->getArcId(eqType, k)])
+					reached[adjacenceList[k]->getId()] = true;
+			}
+		}
+
+		//Every required job must be served by an arc on a depot to depot path
+		vector<bool> served = vector<bool>(data->numJobs, false);
+		for(rvit = data->vertexSet.rbegin(); rvit != data->vertexSet.rend(); rvit++){
+			Vertex *o = (*rvit);
+
+			vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				Vertex *d = adjacenceList[k];
+				if(arcMask[o->getArcId(eqType, k)] || !canReturn[d->getId()]) continue;
+
+				canReturn[o->getId()] = true;
+				if(reached[o->getId()] && d->getJob() != o->getJob())
+					served[o->getJob()] = true;
+			}
+		}
+
+		for(int j=1; j < data->numJobs; j++){
+			if(data->jobs[j]->getEquipmentTypeRequired(eqType) && !served[j]){
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void SubproblemSolver::buildContractedNetwork()
+{
+	chains = vector<vector<WaitingChain>>(data->numEquipments);
+
+	for(int eqType=0; eqType < data->numEquipments; eqType++){
+		set<Vertex*,VertexComparator>::iterator vit = data->vertexSet.begin();
+		for(; vit != data->vertexSet.end(); vit++){
+			Vertex *v = (*vit);
+
+			//Event vertex: the start depot or a vertex entered from another job
+			bool event = (v->getJob() == 0 && v->getTime() == 0);
+			vector<Vertex*> &incidenceList = v->getIncidenceList(eqType);
+			for(unsigned int i=0; i < incidenceList.size() && !event; i++){
+				if(incidenceList[i]->getJob() != v->getJob()) event = true;
+			}
+			if(!event) continue;
+
+			WaitingChain chain;
+			chain.event = v;
+			chain.vertices.push_back(v);
+
+			//Follow the waiting arcs while the next vertex is only entered by the waiting arc
+			Vertex *w = v;
+			while(w != nullptr){
+				Vertex *next = nullptr;
+				vector<Vertex*> &adjacenceList = w->getAdjacenceList(eqType);
+				for(unsigned int k=0; k < adjacenceList.size(); k++){
+					if(adjacenceList[k]->getJob() == w->getJob()) next = adjacenceList[k];
+				}
+				if(next == nullptr || next->getIncidenceList(eqType).size() != 1) break;
+
+				chain.vertices.push_back(next);
+				w = next;
+			}
+			chains[eqType].push_back(chain);
+		}
+	}
+}
+
+int SubproblemSolver::getNumPricingVertices(int eqType)
+{
+	if(parameters->useContractedNetwork()) return chains[eqType].size();
+	return getNumNetworkVertices(eqType);
+}
+
+int SubproblemSolver::getNumNetworkVertices(int eqType)
+{
+	//Vertices of the network with some arc of eqType
+	int numVertices = 0;
+	set<Vertex*,VertexComparator>::iterator vit = data->vertexSet.begin();
+	for(; vit != data->vertexSet.end(); vit++){
+		if((*vit)->getAdjacenceList(eqType).size() > 0 || (*vit)->getIncidenceList(eqType).size() > 0) numVertices++;
+	}
+	return numVertices;
+}
+
+void SubproblemSolver::solve(Node *node, int eqType, int maxRoutes)
+{
+	clock_t solveStart = clock();
+
+	//Reset buckets and reduced costs matrix
+	reset();
+
+	//Update reduced costs matrix
+	double routeUseCost = node->getRouteUseReducedCost(eqType);
+	
+	//Dynamic Programming
+	Vertex *p, *next;
+	int pJob, pTime;
+	int cJob, cTime, nJob, nTime;
+	double rc;
+
+	vector<bool> &arcMask = node->getArcMask();
+
+	setSubsetRowCuts(node, eqType);
+	loadCapacity = (method == QROUTE_NOLOOP)? loadCapacities[eqType] : 0;
+
+	getBucket(0, 0)->addLabel(new Label(0,0,0));
+
+	//Reaching algorithm
+	Vertex *currentVertex, *nextVertex;
+	Bucket *endBucket = getBucket(0, data->horizonLength);
+	set<Vertex*,VertexComparator>::iterator vit = data->vertexSet.begin();
+	set<Vertex*,VertexComparator>::iterator veit = data->vertexSet.end();
+
+	if(data->getNumNetworkShifts() > 1 && subsetRowPenalties.size() == 0){
+		//Shift subproblems (subset row cuts see the whole route, so they are priced on the whole network)
+		solveShifts(node, eqType, routeUseCost);
+		pricingTime += (double)(clock() - solveStart)/CLOCKS_PER_SEC;
+		return;
+	}else if(parameters->useContractedNetwork()){
+		solveContracted(node, eqType);
+	}else{
+		while(vit != veit){
+			currentVertex = (*vit);
+			cJob = currentVertex->getJob();
+			cTime = currentVertex->getTime();
+			vit++;
+
+			vector<Vertex*> &adjacenceList = currentVertex->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				//Arcs removed by branching in this node
+				if(arcMask[currentVertex->getArcId(eqType, k)]) continue;
+
+				nextVertex = adjacenceList[k];
+				nJob = nextVertex->getJob();
+				nTime = nextVertex->getTime();
+
+				rc = (cJob == nJob)? 0 : node->getArcReducedCost(cJob,nJob,cTime,eqType);
+
+				extendLabels(getBucket(currentVertex), getBucket(nextVertex), rc, -1);
+			}
+		}
+	}
+
+	//BUILD ROUTES
+	if(endBucket == nullptr){
+		pricingTime += (double)(clock() - solveStart)/CLOCKS_PER_SEC;
+		return;
+	}
+	Route *myRoute;
+	int contRoutes = 0;
+	set<Label*,LabelComparator>::iterator it = endBucket->getLabels().begin();
+	set<Label*,LabelComparator>::iterator eit = endBucket->getLabels().end();
+	while(it != eit){
+		Label *currentLabel = (*it);
+		if(currentLabel == nullptr){
+			break;
+		}
+
+		myRoute = new Route(eqType);
+		myRoute->setCost(currentLabel->getCost() - routeUseCost);
+
+		if(myRoute->getCost() >= -parameters->getEpsilon()) break; //labels are ordered by reduced cost.
+
+		addRouteEdges(myRoute, currentLabel);
+
+		//Staying at the depot for the whole horizon (work shift decomposition) is not a column
+		if(myRoute->edges.size() == 0){
+			delete myRoute;
+			it++;
+			continue;
+		}
+
+		routes.push_back(myRoute);
+		contRoutes++;
+		if(contRoutes >= parameters->getMaxRoutes())
+			break;
+
+		it++;
+	}
+
+	pricingTime += (double)(clock() - solveStart)/CLOCKS_PER_SEC;
+}
+
+void SubproblemSolver::addRouteEdges(Route *route, Label *label)
+{
+	//Edges of the path of label, from the last one to the first one
+	Label *currentLabel = label;
+	Label *previousLabel = currentLabel->getPredecessor();
+	while(previousLabel != nullptr){
+		if(currentLabel->getJob() != previousLabel->getJob()){ //not waiting
+			//Labels extended from a chain of the contracted network keep their actual departure time
+			int time = (currentLabel->getDepartureTime() >= 0)? currentLabel->getDepartureTime() : previousLabel->getTime();
+			route->edges.push_back(new Edge(previousLabel->getJob(),currentLabel->getJob(), time));
+		}
+		currentLabel = previousLabel;
+		previousLabel = currentLabel->getPredecessor();		
+	}
+}
+
+void SubproblemSolver::solveShifts(Node *node, int eqType, double routeUseCost)
+{
+	//Machines are at the depot between shifts, so the best path of each shift is found on its own and a route
+	//is a path per shift (or a shift at the depot). Shifts share no bucket: paths of shift s start with the
+	//label of the depot vertex at its start and end in shiftEndBuckets[s], so they run concurrently.
+	int numShifts = shiftEndBuckets.size();
+	vector<bool> &arcMask = node->getArcMask();
+
+	//Reduced costs are read from the master before the parallel region
+	vector<double> arcCost = vector<double>(data->numArcs, 0.0);
+	set<Vertex*,VertexComparator>::iterator vit = data->vertexSet.begin();
+	for(; vit != data->vertexSet.end(); vit++){
+		Vertex *o = (*vit);
+		vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+		for(unsigned int k=0; k < adjacenceList.size(); k++){
+			int id = o->getArcId(eqType, k);
+			if(!arcMask[id] && adjacenceList[k]->getJob() != o->getJob())
+				arcCost[id] = node->getArcReducedCost(o->getJob(), adjacenceList[k]->getJob(), o->getTime(), eqType);
+		}
+	}
+
+	for(int s=0; s < numShifts; s++){
+		shiftEndBuckets[s]->reset();
+		int start = s * data->workShiftLength;
+		if(s > 0 && getBucket(0, start) != nullptr) getBucket(0, start)->addLabel(new Label(0,start,0));
+	}
+
+	#pragma omp parallel for num_threads(parameters->getNumThreads()) schedule(dynamic)
+	for(int s=0; s < numShifts; s++){
+		int end = shiftEndBuckets[s]->getTime();
+		set<Vertex*,VertexComparator>::iterator it = shiftFirstVertex[s];
+		for(; it != shiftFirstVertex[s+1]; it++){
+			Vertex *o = (*it);
+			if(getBucket(o)->isEmpty()) continue;
+
+			vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				int id = o->getArcId(eqType, k);
+				if(arcMask[id]) continue;
+
+				Vertex *d = adjacenceList[k];
+				Bucket *to = (d->getJob() == 0 && d->getTime() == end)? shiftEndBuckets[s] : getBucket(d);
+				extendLabels(getBucket(o), to, arcCost[id], -1);
+			}
+		}
+	}
+
+	//Best paths of each shift (ordered by reduced cost)
+	vector<vector<Label*>> shiftLabels = vector<vector<Label*>>(numShifts);
+	double bestCost = 0.0;
+	for(int s=0; s < numShifts; s++){
+		shiftLabels[s] = vector<Label*>(shiftEndBuckets[s]->getLabels().begin(), shiftEndBuckets[s]->getLabels().end());
+		if(shiftLabels[s].size() == 0) return;
+		bestCost += shiftLabels[s][0]->getCost();
+	}
+
+	//Routes: the best path of every shift, then the best path of every shift but one, replaced by another one
+	vector<pair<double,pair<int,int>>> candidates;
+	candidates.push_back(make_pair(bestCost, make_pair(0, 0)));
+	for(int s=0; s < numShifts; s++){
+		for(unsigned int k=1; k < shiftLabels[s].size(); k++){
+			candidates.push_back(make_pair(bestCost - shiftLabels[s][0]->getCost() + shiftLabels[s][k]->getCost(), make_pair(s, (int)k)));
+		}
+	}
+	sort(candidates.begin(), candidates.end());
+
+	for(unsigned int c=0; c < candidates.size() && (int)routes.size() < parameters->getMaxRoutes(); c++){
+		if(candidates[c].first - routeUseCost >= -parameters->getEpsilon()) break;
+
+		Route *myRoute = new Route(eqType);
+		myRoute->setCost(candidates[c].first - routeUseCost);
+		for(int s=numShifts-1; s >= 0; s--){
+			int k = (s == candidates[c].second.first)? candidates[c].second.second : 0;
+			addRouteEdges(myRoute, shiftLabels[s][k]);
+		}
+
+		//Staying at the depot for the whole horizon is not a column
+		if(myRoute->edges.size() == 0){
+			delete myRoute;
+			continue;
+		}
+		routes.push_back(myRoute);
+	}
+}
+
+void SubproblemSolver::solveContracted(Node *node, int eqType)
+{
+	//Reaching algorithm over the event vertices: the labels of an event vertex leave it from every vertex
+	//of its chain (with the departure time of that vertex) and wait at the end of the chain for the next event
+	vector<bool> &arcMask = node->getArcMask();
+
+	for(unsigned int c=0; c < chains[eqType].size(); c++){
+		WaitingChain &chain = chains[eqType][c];
+		int job = chain.event->getJob();
+		Bucket *from = getBucket(chain.event);
+		if(from->isEmpty()) continue;
+
+		for(unsigned int i=0; i < chain.vertices.size(); i++){
+			Vertex *v = chain.vertices[i];
+			Vertex *wait = nullptr;
+
+			vector<Vertex*> &adjacenceList = v->getAdjacenceList(eqType);
+			for(unsigned int k=0; k < adjacenceList.size(); k++){
+				//Arcs removed by branching in this node
+				if(arcMask[v->getArcId(eqType, k)]) continue;
+
+				Vertex *d = adjacenceList[k];
+				if(d->getJob() == job){
+					wait = d;
+					continue;
+				}
+				double rc = node->getArcReducedCost(job, d->getJob(), v->getTime(), eqType);
+				extendLabels(from, getBucket(d), rc, v->getTime());
+			}
+
+			//A waiting arc removed by branching cuts the chain, the last one enters the next event vertex
+			if(wait == nullptr) break;
+			if(i+1 == chain.vertices.size()) extendLabels(from, getBucket(wait), 0, -1);
+		}
+	}
+}
+
+void SubproblemSolver::extendLabels(Bucket *from, Bucket *to, double rc, int departure)
+{
+	if(subsetRowPenalties.size() > 0)
+		extendSubsetRowLabels(from, to, rc, departure);
+	else if(loadCapacity > 0)
+		extendLoadLabels(from, to, rc, departure);
+	else
+		to->evaluate(from->getLabels(), rc, false, departure);
+}
+
+void SubproblemSolver::setSubsetRowCuts(Node *node, int eqType)
+{
+	//Penalty (-dual) and job masks of the active subset row cuts (one state bit per cut, QROUTE_NOLOOP only)
+	subsetRowPenalties.clear();
+	subsetRowJobs = vector<unsigned long long>(data->numJobs, 0);
+	subsetRowMemory = vector<unsigned long long>(data->numJobs, 0);
+	subsetRowMemory[0] = ~0ULL; //the depot does not reset the memory
+
+	if(method != QROUTE_NOLOOP) return;
+
+	vector<Cut*> subsetRow = node->getSubsetRowCuts(eqType);
+	for(unsigned int c=0; c < subsetRow.size() && c < 64; c++){
+		unsigned long long bit = 1ULL << c;
+		subsetRowPenalties.push_back(max(0.0, -node->getCutDual(subsetRow[c]->getId())));
+		for(unsigned int k=0; k < subsetRow[c]->jobs.size(); k++){
+			subsetRowJobs[subsetRow[c]->jobs[k]] |= bit;
+		}
+		for(unsigned int k=0; k < subsetRow[c]->memory.size(); k++){
+			subsetRowMemory[subsetRow[c]->memory[k]] |= bit;
+		}
+	}
+}
+
+void SubproblemSolver::extendSubsetRowLabels(Bucket *from, Bucket *to, double rc, int departure)
+{
+	//Every label of the predecessor bucket is extended (labels with different states may not dominate each other)
+	int job = to->getJob();
+	set<Label*,LabelComparator>::iterator it = from->getLabels().begin();
+	for(; it != from->getLabels().end(); it++){
+		Label *pLabel = (*it);
+		Label *predecessor = pLabel->getPredecessor();
+		//Avoid Loop
+		if(job != 0){
+			if(predecessor != nullptr && predecessor->getJob() == job) continue;
+		}
+
+		//Loads over the capacity (the depot unloads)
+		int load = (job == 0)? 0 : pLabel->getLoad();
+		if(pLabel->getJob() != job && job != 0) load += data->jobs[job]->getDemand();
+		if(loadCapacity > 0 && load > loadCapacity) continue;
+
+		Label *myLabel = new Label(job, to->getTime(), pLabel->getCost() + rc);
+		myLabel->setLoad(load);
+		unsigned long long state = pLabel->getSubsetRowState();
+		if(pLabel->getJob() != job){
+			myLabel->setPredecessor(pLabel);
+			myLabel->setDepartureTime(departure);
+
+			//Visit to job: forget the cuts out of memory, then pay the cuts visited for the second time
+			state &= subsetRowMemory[job];
+			unsigned long long paid = state & subsetRowJobs[job];
+			for(unsigned int c=0; c < subsetRowPenalties.size(); c++){
+				if(paid & (1ULL << c)) myLabel->setCost(myLabel->getCost() + subsetRowPenalties[c]);
+			}
+			state ^= subsetRowJobs[job];
+		}else{
+			myLabel->setPredecessor(predecessor);
+			myLabel->setDepartureTime(pLabel->getDepartureTime());
+		}
+		myLabel->setSubsetRowState(state);
+
+		to->addNonDominated(myLabel, subsetRowPenalties);
+	}
+}
+
+void SubproblemSolver::extendLoadLabels(Bucket *from, Bucket *to, double rc, int departure)
+{
+	//Every label of the predecessor bucket is extended while it fits the capacity, the bucket keeps the
+	//labels not dominated in cost and load. The depot unloads: its buckets keep the best routes
+	int job = to->getJob();
+	if(job == 0){
+		to->evaluate(from->getLabels(), rc, false, departure);
+		return;
+	}
+	int demand = data->jobs[job]->getDemand();
+	set<Label*,LabelComparator>::iterator it = from->getLabels().begin();
+	for(; it != from->getLabels().end(); it++){
+		Label *pLabel = (*it);
+		Label *predecessor = pLabel->getPredecessor();
+		//Avoid Loop
+		if(predecessor != nullptr && predecessor->getJob() == job) continue;
+
+		Label *myLabel;
+		if(pLabel->getJob() != job){
+			int load = pLabel->getLoad() + demand;
+			if(load > loadCapacity) continue;
+
+			myLabel = new Label(job, to->getTime(), pLabel->getCost() + rc, pLabel);
+			myLabel->setDepartureTime(departure);
+			myLabel->setLoad(load);
+		}else{
+			myLabel = new Label(job, to->getTime(), pLabel->getCost() + rc, predecessor);
+			myLabel->setDepartureTime(pLabel->getDepartureTime());
+			myLabel->setLoad(pLabel->getLoad());
+		}
+
+		static_cast<ParetoBucket*>(to)->addParetoLabel(myLabel);
+	}
+}
+
+bool SubproblemSolver::enumerate(Node *node, int eqType, double maxReducedCost, int maxRoutes)
+{
+	//All the elementary routes with reduced cost <= maxReducedCost (false if there are more than maxRoutes)
+	routes.clear();
+
+	double routeUseCost = node->getRouteUseReducedCost(eqType);
+	double eps = parameters->getEpsilon();
+	vector<bool> &arcMask = node->getArcMask();
+	int capacity = loadCapacities[eqType];
+
+	//Reduced cost of every arc of the network (waiting arcs are free)
+	vector<double> arcCost = vector<double>(data->numArcs, 0.0);
+	set<Vertex*,VertexComparator>::iterator vit;
+	set<Vertex*,VertexComparator>::reverse_iterator rvit;
+	for(vit = data->vertexSet.begin(); vit != data->vertexSet.end(); vit++){
+		Vertex *o = (*vit);
+		vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+		for(unsigned int k=0; k < adjacenceList.size(); k++){
+			if(adjacenceList[k]->getJob() != o->getJob())
+				arcCost[o->getArcId(eqType, k)] = node->getArcReducedCost(o->getJob(), adjacenceList[k]->getJob(), o->getTime(), eqType);
+		}
+	}
+
+	//Completion bound: cheapest (not necessarily elementary) path from each vertex to the end depot
+	vector<vector<double>> completion = vector<vector<double>>(data->numJobs, vector<double>(data->horizonLength+1, infinityValue));
+	completion[0][data->horizonLength] = 0;
+	for(rvit = data->vertexSet.rbegin(); rvit != data->vertexSet.rend(); rvit++){
+		Vertex *o = (*rvit);
+		vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+		for(unsigned int k=0; k < adjacenceList.size(); k++){
+			int id = o->getArcId(eqType, k);
+			Vertex *d = adjacenceList[k];
+			if(arcMask[id] || completion[d->getJob()][d->getTime()] >= infinityValue) continue;
+			completion[o->getJob()][o->getTime()] = min(completion[o->getJob()][o->getTime()], arcCost[id] + completion[d->getJob()][d->getTime()]);
+		}
+	}
+
+	if(completion[0][0] - routeUseCost > maxReducedCost + eps) return true;
+
+	//Depth first search of the depot to depot paths, cut by the completion bound
+	struct PathStep
+	{
+		Vertex *vertex;
+		unsigned int nextArc;
+		double cost;
+		int load;
+	};
+	vector<PathStep> path;
+	vector<bool> visited = vector<bool>(data->numJobs, false);
+	PathStep start = {data->problemNetwork.get(0, 0), 0, 0.0, 0};
+	path.push_back(start);
+
+	while(path.size() > 0){
+		PathStep &step = path.back();
+		Vertex *o = step.vertex;
+		vector<Vertex*> &adjacenceList = o->getAdjacenceList(eqType);
+
+		//Backtrack, the job is free again once its first time copy leaves the path
+		if(step.nextArc >= adjacenceList.size()){
+			if(path.size() < 2 || path[path.size()-2].vertex->getJob() != o->getJob())
+				visited[o->getJob()] = false;
+			path.pop_back();
+			continue;
+		}
+
+		int id = o->getArcId(eqType, step.nextArc);
+		Vertex *d = adjacenceList[step.nextArc];
+		step.nextArc++;
+		if(arcMask[id]) continue;
+
+		//Elementarity (the depot may be visited again)
+		int dJob = d->getJob();
+		if(dJob != o->getJob() && dJob != 0 && visited[dJob]) continue;
+
+		double cost = step.cost + arcCost[id];
+		if(cost + completion[dJob][d->getTime()] - routeUseCost > maxReducedCost + eps) continue;
+
+		//Capacity (the depot unloads)
+		int load = (dJob == 0)? 0 : step.load;
+		if(dJob != o->getJob() && dJob != 0) load += data->jobs[dJob]->getDemand();
+		if(capacity > 0 && load > capacity) continue;
+
+		if(dJob != 0 || d->getTime() != data->horizonLength){
+			if(dJob != o->getJob()) visited[dJob] = true;
+			PathStep next = {d, 0, cost, load};
+			path.push_back(next);
+			continue;
+		}
+
+		//End depot reached: the edges are stored from the last one to the first one, as in solve
+		Route *myRoute = new Route(eqType);
+		myRoute->setCost(cost - routeUseCost);
+		Vertex *current = d;
+		for(int i=path.size()-1; i >= 0; i--){
+			Vertex *previous = path[i].vertex;
+			if(previous->getJob() != current->getJob())
+				myRoute->edges.push_back(new Edge(previous->getJob(), current->getJob(), previous->getTime()));
+			current = previous;
+		}
+
+		//The empty route is not a column
+		if(myRoute->edges.size() == 0){
+			delete myRoute;
+			continue;
+		}
+
+		if((int)routes.size() >= maxRoutes){
+			delete myRoute;
+			return false;
+		}
+		routes.push_back(myRoute);
+	}
+
+	return true;
+}
@@ -1,56 +1,110 @@
-#include "Data.h"
-#include "Bucket.h"
-#include "Route.h"
-
-#include <vector>
-#include <set>
-
-#ifdef DEBUG
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
-#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
-#define new DEBUG_NEW
-#endif
-
-using namespace std;
-
-enum SubproblemType
-{
-	QROUTE,
-	QROUTE_NOLOOP,
-	NGROUTE
-};
-
-class Node;
-class Solver;
-
-class SubproblemSolver
-{
-	
-public:
-	SubproblemSolver(ProblemData * d, SubproblemType m);
-	~SubproblemSolver();
-
-	vector<Route*> routes;
-
-	void reset();
-	void solve(Node *node, int eqType, int maxRoutes);
-	void collapseVertices(Node *node, int eqType);
-	bool isInfeasible(){ return infeasible; }	
-
-private:
-	ProblemData * data;
-	SubproblemType method;
-	GlobalParameters *parameters;
-
-	double infinityValue;
-	bool infeasible;
-
-	vector<vector<bool>> visited;
-	vector<vector<vector<double>>> reducedCosts;
-	vector<vector<Bucket*>> fMatrix;
-	vector<int> fixatedVars;
-
-};
-
+#include "Data.h"
+#include "Bucket.h"
+#include "Route.h"
+#include "Node.h"
+
+#include <vector>
+#include <set>
+
+#ifdef DEBUG
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+using namespace std;
+
+enum SubproblemType
+{
+	QROUTE,
+	QROUTE_NOLOOP,
+	NGROUTE
+};
+
+class Node;
+class Solver;
+
+class SubproblemSolver
+{
+	
+public:
+	SubproblemSolver(ProblemData * d, SubproblemType m);
+	~SubproblemSolver();
+
+	vector<Route*> routes;
+
+	void reset();
+	void solve(Node *node, int eqType, int maxRoutes);
+	bool enumerate(Node *node, int eqType, double maxReducedCost, int maxRoutes);
+	bool propagateBranching(Node *node);
+	bool isRouteAllowed(Node *node, Route *route);
+	bool isInfeasible(){ return infeasible; }	
+
+	//Pricing statistics: time spent in solve and vertices of the (contracted) network of eqType
+	double getPricingTime(){ return pricingTime; }
+	int getNumPricingVertices(int eqType);
+	int getNumNetworkVertices(int eqType);
+
+private:
+	ProblemData * data;
+	SubproblemType method;
+	GlobalParameters *parameters;
+
+	double infinityValue;
+	bool infeasible;
+
+	vector<Bucket*> buckets; //one per vertex of the problem network, by vertex id
+	Bucket *getBucket(Vertex *v){ return buckets[v->getId()]; }
+	Bucket *getBucket(int job, int time);
+	double pricingTime;
+
+	//Contracted network ([eqType], in topological order): each event vertex (start depot or entered from
+	//another job) with the chain of vertices of its job that are only entered by waiting arcs after it.
+	//Those have the same labels as the event vertex, so only event vertices keep labels.
+	struct WaitingChain
+	{
+		Vertex *event;
+		vector<Vertex*> vertices; //the event vertex first, then its chain in time order
+	};
+	vector<vector<WaitingChain>> chains;
+	void buildContractedNetwork();
+	void solveContracted(Node *node, int eqType);
+	void extendLabels(Bucket *from, Bucket *to, double rc, int departure);
+
+	//Work shift decomposition: first vertex of each shift (in topological order, the last one is the end of
+	//the set) and bucket of the routes of each shift, which end at the depot vertex that starts the next one
+	vector<set<Vertex*,VertexComparator>::iterator> shiftFirstVertex;
+	vector<Bucket*> shiftEndBuckets;
+	void solveShifts(Node *node, int eqType, double routeUseCost);
+
+	Bucket *createBucket(int job, int time);
+	void addRouteEdges(Route *route, Label *label);
+
+	//Active subset row cuts of the last solve (penalty of cut c and masks [job] with bit c set)
+	vector<double> subsetRowPenalties;
+	vector<unsigned long long> subsetRowJobs;
+	vector<unsigned long long> subsetRowMemory;
+	void setSubsetRowCuts(Node *node, int eqType);
+	void extendSubsetRowLabels(Bucket *from, Bucket *to, double rc, int departure);
+
+	//Capacity of the equipment type of the last solve when its load is a resource of the labels (0 = none).
+	//If any equipment type has one, the buckets of the jobs are ParetoBuckets; depot buckets keep the best labels
+	int loadCapacity;
+	vector<int> loadCapacities;
+	bool loadResource;
+	void extendLoadLabels(Bucket *from, Bucket *to, double rc, int departure);
+
+	//Branching decisions over the arc mask of a node
+	int getArcId(int sJob, int dJob, int time, int eqType);
+	void removeArc(Node *node, int id){ node->getArcMask()[id] = true; }
+	void removeServiceArcs(Node *node, Vertex *v, int eqType, int keepJob);
+	void removeIncomingArcs(Node *node, int job, int eqType, int keepJob);
+	void fixArc(Node *node, int sJob, int dJob, int time, int eqType);
+	void applyFlowBranch(Node *node, int sJob, int dJob, int eqType, bool used);
+	void applyTimeWindow(Node *node, int job);
+	bool isNetworkFeasible(Node *node);
+
+};
+